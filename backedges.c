@@ -0,0 +1,219 @@
+#include "backedges.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BACKEDGES_X86 /*!< AVX2 kernel can be compiled */
+#endif
+
+/**
+ * @file backedges.c
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ */
+
+/**
+ * @brief Signature of a classification kernel
+ */
+typedef size_t (*classify_fn_t)(const edge_soa_t* pSoa, const vertex_t* pPos, size_t limit, uint32_t* pIdx);
+
+/**
+ * @brief       Classify Scalar From
+ * @details     This internal method is used to classify the edges from the given index on, one at a time.
+ *              An edge is a back edge if the position of its start vertex is bigger than the one of its end vertex.
+ *
+ * @param       pSoa    Pointer to the edges
+ * @param       pPos    Pointer to the positions of the vertices, indexed by the vertex id
+ * @param       limit   The classification stops as soon as this number of back edges was found
+ * @param       pIdx    Pointer to the array where the indexes of the back edges get written to
+ * @param       first   Index of the first edge which should be classified
+ * @param       cnt     Number of back edges which were already found
+ *
+ * @return      Number of back edges
+ */
+static size_t classify_scalar_from(const edge_soa_t* pSoa, const vertex_t* pPos, size_t limit, uint32_t* pIdx,
+                                   size_t first, size_t cnt)
+{
+    for (size_t i = first; i < pSoa->edgeCnt; i++)
+    {
+        if (pPos[pSoa->pStart[i]] > pPos[pSoa->pEnd[i]])
+        {
+            pIdx[cnt] = (uint32_t)i;
+            cnt++;
+
+            if (limit <= cnt)
+            {
+                break;
+            }
+        }
+    }
+
+    return cnt;
+}
+
+/**
+ * @brief       Classify Scalar
+ * @details     This internal method is the fallback kernel, if the CPU does not support AVX2.
+ *
+ * @param       pSoa    Pointer to the edges
+ * @param       pPos    Pointer to the positions of the vertices, indexed by the vertex id
+ * @param       limit   The classification stops as soon as this number of back edges was found
+ * @param       pIdx    Pointer to the array where the indexes of the back edges get written to
+ *
+ * @return      Number of back edges
+ */
+static size_t classify_scalar(const edge_soa_t* pSoa, const vertex_t* pPos, size_t limit, uint32_t* pIdx)
+{
+    return classify_scalar_from(pSoa, pPos, limit, pIdx, 0U, 0U);
+}
+
+#ifdef BACKEDGES_X86
+/**
+ * @brief       Classify AVX2
+ * @details     This internal method classifies eight edges at once.
+ *              The vertices are widened to 32 bit (if needed), the positions get gathered and compared, the resulting
+ *              mask is compacted into the index list. The remaining edges are done by the scalar kernel.
+ *
+ * @note        With 16 bit vertices the gather loads 32 bit at the position of a vertex, so the position array needs
+ *              one element more than the id space.
+ *
+ * @param       pSoa    Pointer to the edges
+ * @param       pPos    Pointer to the positions of the vertices, indexed by the vertex id
+ * @param       limit   The classification stops as soon as this number of back edges was found
+ * @param       pIdx    Pointer to the array where the indexes of the back edges get written to
+ *
+ * @return      Number of back edges
+ */
+__attribute__((target("avx2"))) static size_t classify_avx2(const edge_soa_t* pSoa, const vertex_t* pPos,
+                                                            size_t limit, uint32_t* pIdx)
+{
+#ifndef VERTEX_32BIT
+    const __m256i lowMask = _mm256_set1_epi32(0xFFFF);
+#endif
+    size_t cnt = 0U;
+    size_t i = 0U;
+
+    for (; (i + 8U) <= pSoa->edgeCnt; i += 8U)
+    {
+#ifdef VERTEX_32BIT
+        __m256i start = _mm256_loadu_si256((const __m256i*)&pSoa->pStart[i]);
+        __m256i end = _mm256_loadu_si256((const __m256i*)&pSoa->pEnd[i]);
+        __m256i posStart = _mm256_i32gather_epi32((const int*)pPos, start, 4);
+        __m256i posEnd = _mm256_i32gather_epi32((const int*)pPos, end, 4);
+#else
+        __m256i start = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)&pSoa->pStart[i]));
+        __m256i end = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)&pSoa->pEnd[i]));
+        __m256i posStart = _mm256_and_si256(_mm256_i32gather_epi32((const int*)pPos, start, 2), lowMask);
+        __m256i posEnd = _mm256_and_si256(_mm256_i32gather_epi32((const int*)pPos, end, 2), lowMask);
+#endif
+        uint32_t mask = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(posStart, posEnd)));
+
+        // compact the set bits into the index list
+        while (0U != mask)
+        {
+            pIdx[cnt] = (uint32_t)(i + (size_t)__builtin_ctz(mask));
+            cnt++;
+
+            if (limit <= cnt)
+            {
+                return cnt;
+            }
+
+            mask &= mask - 1U;
+        }
+    }
+
+    return classify_scalar_from(pSoa, pPos, limit, pIdx, i, cnt);
+}
+#endif
+
+static classify_fn_t gClassify = classify_scalar; /*!< kernel which is used, chosen by backedges_init */
+
+/**
+ * @brief       Backedges Init
+ * @details     This method is used to choose the classification kernel for the CPU the application is running on.
+ */
+void backedges_init(void)
+{
+#ifdef BACKEDGES_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        gClassify = classify_avx2;
+        return;
+    }
+#endif
+
+    gClassify = classify_scalar;
+}
+
+/**
+ * @brief       Backedges SoA Create
+ * @details     This method is used to copy the edges into a structure of arrays.
+ *
+ * @param       pEdges      Pointer to the array of edges
+ * @param       edgeCnt     Number of edges
+ * @param       pSoa        Pointer to the structure of arrays (write)
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ */
+error_t backedges_soa_create(const edge_t* pEdges, size_t edgeCnt, edge_soa_t* pSoa)
+{
+    pSoa->pStart = malloc(sizeof(vertex_t) * edgeCnt);
+    pSoa->pEnd = malloc(sizeof(vertex_t) * edgeCnt);
+    pSoa->edgeCnt = edgeCnt;
+
+    if ((NULL == pSoa->pStart) || (NULL == pSoa->pEnd))
+    {
+        backedges_soa_free(pSoa);
+        return ERROR_NULLPTR;
+    }
+
+    for (size_t i = 0U; i < edgeCnt; i++)
+    {
+        pSoa->pStart[i] = pEdges[i].start;
+        pSoa->pEnd[i] = pEdges[i].end;
+    }
+
+    return ERROR_OK;
+}
+
+/**
+ * @brief       Backedges SoA Free
+ * @details     This method is used to free the memory of a structure of arrays.
+ *
+ * @param       pSoa        Pointer to the structure of arrays
+ */
+void backedges_soa_free(edge_soa_t* pSoa)
+{
+    free(pSoa->pStart);
+    free(pSoa->pEnd);
+    pSoa->pStart = NULL;
+    pSoa->pEnd = NULL;
+    pSoa->edgeCnt = 0U;
+}
+
+/**
+ * @brief       Backedges Classify
+ * @details     This method is used to find all back edges of an order of the vertices.
+ *              An edge is a back edge if the position of its start vertex is bigger than the one of its end vertex.
+ *              The indexes of the back edges are written compacted to the index list.
+ *
+ * @param       pSoa    Pointer to the edges
+ * @param       pPos    Pointer to the positions of the vertices, indexed by the vertex id (one element more than the
+ *                      id space, see classify_avx2)
+ * @param       limit   The classification stops as soon as this number of back edges was found
+ * @param       pIdx    Pointer to the array where the indexes of the back edges get written to (at least limit
+ *                      elements, or the number of edges)
+ *
+ * @return      Number of back edges (at most limit)
+ */
+size_t backedges_classify(const edge_soa_t* pSoa, const vertex_t* pPos, size_t limit, uint32_t* pIdx)
+{
+    return gClassify(pSoa, pPos, limit, pIdx);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+/**
+ * @file  backedges.h
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ * @brief Classification of the edges against an order of the vertices
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common.h"
+#include "errors.h"
+
+/*!
+ * @struct edge_soa_t
+ * @brief  Edges as structure of arrays
+ *
+ * @details The start and end vertices are stored in two separate arrays, so that the classification kernel can load
+ *          a whole block of vertices at once.
+ **/
+typedef struct
+{
+    vertex_t* pStart; /*!< start vertices */
+    vertex_t* pEnd;   /*!< end vertices */
+    size_t edgeCnt;   /*!< number of edges */
+} edge_soa_t;
+
+/* **** FUNCTIONS **** */
+void backedges_init(void);
+error_t backedges_soa_create(const edge_t* pEdges, size_t edgeCnt, edge_soa_t* pSoa);
+void backedges_soa_free(edge_soa_t* pSoa);
+size_t backedges_classify(const edge_soa_t* pSoa, const vertex_t* pPos, size_t limit, uint32_t* pIdx);
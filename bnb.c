@@ -0,0 +1,766 @@
+#include "bnb.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file bnb.c
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ */
+
+/*!
+ * @struct bnb_task_t
+ * @brief  Node of the search tree, a prefix of the vertex order
+ **/
+typedef struct
+{
+    uint64_t placed;             /*!< vertices which are placed already */
+    uint32_t cost;               /*!< back edges of the placed vertices */
+    uint32_t depth;              /*!< number of placed vertices */
+    uint8_t order[BNB_MAX_VERT]; /*!< placed vertices in their order */
+} bnb_task_t;
+
+/*!
+ * @struct bnb_deque_t
+ * @brief  Work-stealing deque of one worker (Chase-Lev)
+ *
+ * @details Only the owner pushes and pops at the bottom, so it works on the newest (deepest) tasks and goes depth
+ *          first. Idle workers steal the oldest tasks at the top, which are the biggest subtrees. Both ends are on
+ *          their own cache line. The ring has a fixed size, a task which does not fit is expanded in place.
+ **/
+typedef struct
+{
+    int64_t top CACHE_ALIGNED;    /*!< index of the oldest task, thieves take it from here (atomic) */
+    int64_t bottom CACHE_ALIGNED; /*!< index after the newest task, only the owner changes it (atomic) */
+    bnb_task_t* pTasks;           /*!< ring of BNB_DEQUE_SIZE tasks */
+} bnb_deque_t;
+
+/*!
+ * @struct bnb_entry_t
+ * @brief  Entry of the table of the expanded vertex sets
+ *
+ * @details The completions of a prefix only depend on the set of its vertices, not on their order. So a prefix is
+ *          not needed if the same set was expanded with a cost which is not higher. An entry which is locked by
+ *          another worker is skipped, the table only saves work and never has to be right about a set it misses.
+ **/
+typedef struct
+{
+    uint64_t placed; /*!< set of the placed vertices */
+    uint32_t cost;   /*!< back edges with which the set was expanded, plus one (0 for an empty entry) */
+    uint32_t lock;   /*!< entry is read or written by a worker (atomic) */
+} bnb_entry_t;
+
+/*!
+ * @struct bnb_shared_t
+ * @brief  State which is shared by all workers
+ **/
+typedef struct
+{
+    uint64_t out[BNB_MAX_VERT];    /*!< successors of every vertex */
+    uint64_t in[BNB_MAX_VERT];     /*!< predecessors of every vertex */
+    uint64_t mutual[BNB_MAX_VERT]; /*!< successors which are predecessors too (2-cycles), only the higher ids */
+    uint64_t all;                  /*!< mask of all vertices */
+    const bnb_problem_t* pProb;    /*!< problem which is solved */
+    bnb_deque_t* pDeques;          /*!< deque of every worker */
+    size_t threadCnt;              /*!< number of workers */
+    bnb_entry_t* pTable;           /*!< table of the expanded vertex sets, 2^BNB_TABLE_BITS entries */
+
+    int64_t busy CACHE_ALIGNED; /*!< workers which hold a task or have tasks in their deque (atomic) */
+    uint64_t nodes;             /*!< nodes of all workers, counted every BNB_CHECK_NODES (atomic) */
+
+    uint32_t bound CACHE_ALIGNED;    /*!< orders with this cost or more are not searched anymore (atomic) */
+    bool aborted;                    /*!< search was aborted from outside (atomic) */
+    pthread_mutex_t lock;            /*!< protects the best order */
+    bool found;                      /*!< an order below the incumbent was found */
+    uint32_t bestCost;               /*!< back edges of the best order */
+    uint8_t bestOrder[BNB_MAX_VERT]; /*!< best order */
+} bnb_shared_t;
+
+/*!
+ * @struct bnb_worker_t
+ * @brief  Thread of the search
+ **/
+typedef struct
+{
+    bnb_shared_t* pShared; /*!< state of all workers */
+    size_t id;             /*!< number of the worker, also the number of its deque */
+    uint64_t nodes;        /*!< nodes expanded by this worker */
+    pthread_t thread;      /*!< thread of the worker */
+    bool started;          /*!< thread was started and has to be joined */
+} bnb_worker_t;
+
+/**
+ * @brief       Push
+ * @details     This internal method is used by the owner to put a task on the bottom of its deque.
+ *              The task is written before the new bottom gets visible, so a thief never sees a half written task.
+ *
+ * @param       pDeque      Pointer to the deque of the worker
+ * @param       pTask       Pointer to the task
+ *
+ * @return      true if the task was pushed, false if the deque is full
+ */
+static bool deque_push(bnb_deque_t* pDeque, const bnb_task_t* pTask)
+{
+    int64_t bottom = __atomic_load_n(&pDeque->bottom, __ATOMIC_RELAXED);
+    int64_t top = __atomic_load_n(&pDeque->top, __ATOMIC_ACQUIRE);
+
+    if ((int64_t)BNB_DEQUE_SIZE <= (bottom - top))
+    {
+        return false;
+    }
+
+    pDeque->pTasks[(uint64_t)bottom & (BNB_DEQUE_SIZE - 1U)] = *pTask;
+    __atomic_store_n(&pDeque->bottom, bottom + 1, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+/**
+ * @brief       Pop
+ * @details     This internal method is used by the owner to take the newest task from the bottom of its deque.
+ *              The bottom is lowered first, so thieves cannot take the same task. Only if it is the last task, the
+ *              owner races with the thieves for it with a compare and swap on the top.
+ *
+ * @param       pDeque      Pointer to the deque of the worker
+ * @param       pTask       Pointer to the task (write)
+ *
+ * @return      true if a task was taken, false if the deque is empty
+ */
+static bool deque_pop(bnb_deque_t* pDeque, bnb_task_t* pTask)
+{
+    int64_t bottom = __atomic_load_n(&pDeque->bottom, __ATOMIC_RELAXED) - 1;
+    int64_t top = 0;
+    bool taken = true;
+
+    __atomic_store_n(&pDeque->bottom, bottom, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    top = __atomic_load_n(&pDeque->top, __ATOMIC_RELAXED);
+
+    if (top > bottom)
+    {
+        // empty
+        __atomic_store_n(&pDeque->bottom, bottom + 1, __ATOMIC_RELAXED);
+        return false;
+    }
+
+    *pTask = pDeque->pTasks[(uint64_t)bottom & (BNB_DEQUE_SIZE - 1U)];
+
+    if (top == bottom)
+    {
+        // last task, a thief might take it at the same time
+        taken = __atomic_compare_exchange_n(&pDeque->top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+        __atomic_store_n(&pDeque->bottom, bottom + 1, __ATOMIC_RELAXED);
+    }
+
+    return taken;
+}
+
+/**
+ * @brief       Steal
+ * @details     This internal method is used by an idle worker to take the oldest task from the top of another deque.
+ *              The task is copied first and only kept if the top could be moved on, otherwise the owner or another
+ *              thief was faster.
+ *
+ * @param       pDeque      Pointer to the deque of the other worker
+ * @param       pTask       Pointer to the task (write)
+ *
+ * @return      true if a task was taken
+ */
+static bool deque_steal(bnb_deque_t* pDeque, bnb_task_t* pTask)
+{
+    int64_t top = __atomic_load_n(&pDeque->top, __ATOMIC_ACQUIRE);
+    int64_t bottom = 0;
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    bottom = __atomic_load_n(&pDeque->bottom, __ATOMIC_ACQUIRE);
+
+    if (top >= bottom)
+    {
+        return false;
+    }
+
+    *pTask = pDeque->pTasks[(uint64_t)top & (BNB_DEQUE_SIZE - 1U)];
+
+    return __atomic_compare_exchange_n(&pDeque->top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief       Place
+ * @details     This internal method is used to put a vertex behind the placed ones. Its edges to them are back edges.
+ *
+ * @param       pShared     Pointer to the state of all workers
+ * @param       pTask       Pointer to the task (read and write)
+ * @param       vert        Vertex which gets placed
+ */
+static void place(const bnb_shared_t* pShared, bnb_task_t* pTask, uint32_t vert)
+{
+    pTask->cost += (uint32_t)__builtin_popcountll(pShared->out[vert] & pTask->placed);
+    pTask->placed |= 1ULL << vert;
+    pTask->order[pTask->depth] = (uint8_t)vert;
+    pTask->depth++;
+}
+
+/**
+ * @brief       Search Bound
+ * @details     This internal method is used to get the cost from which on orders are not needed anymore.
+ *              This is the best order of the workers, or one above the incumbent, so an order as good as the
+ *              incumbent is still found and can be returned.
+ *
+ * @param       pShared     Pointer to the state of all workers
+ *
+ * @return      bound       Orders with this cost or more are pruned
+ */
+static uint32_t search_bound(bnb_shared_t* pShared)
+{
+    uint32_t bound = __atomic_load_n(&pShared->bound, __ATOMIC_RELAXED);
+    size_t incumbent = SIZE_MAX;
+
+    if (NULL != pShared->pProb->pIncumbent)
+    {
+        incumbent = __atomic_load_n(pShared->pProb->pIncumbent, __ATOMIC_RELAXED);
+    }
+
+    if (incumbent < bound)
+    {
+        bound = (uint32_t)incumbent + 1U;
+    }
+
+    return bound;
+}
+
+/**
+ * @brief       Check Abort
+ * @details     This internal method is used to stop the search if the generators should stop, the component was
+ *              solved by someone else or the node budget is used up.
+ *
+ * @param       pShared     Pointer to the state of all workers
+ * @param       spent       Nodes the worker expanded since it checked the last time
+ *
+ * @return      true if the search is aborted
+ */
+static bool check_abort(bnb_shared_t* pShared, uint64_t spent)
+{
+    const bnb_problem_t* pProb = pShared->pProb;
+    uint64_t nodes = __atomic_add_fetch(&pShared->nodes, spent, __ATOMIC_RELAXED);
+
+    if (((NULL != pProb->pActive) && (false == __atomic_load_n(pProb->pActive, __ATOMIC_ACQUIRE))) ||
+        ((NULL != pProb->pSolved) && __atomic_load_n(pProb->pSolved, __ATOMIC_RELAXED)) ||
+        ((0U != pProb->nodeBudget) && (nodes >= pProb->nodeBudget)))
+    {
+        __atomic_store_n(&pShared->aborted, true, __ATOMIC_RELAXED);
+    }
+
+    return __atomic_load_n(&pShared->aborted, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief       Report
+ * @details     This internal method is used to keep a complete order if it is the best so far. Its cost is the new
+ *              bound of all workers.
+ *
+ * @param       pShared     Pointer to the state of all workers
+ * @param       pTask       Pointer to the complete order
+ */
+static void report(bnb_shared_t* pShared, const bnb_task_t* pTask)
+{
+    pthread_mutex_lock(&pShared->lock);
+
+    if ((false == pShared->found) || (pTask->cost < pShared->bestCost))
+    {
+        pShared->found = true;
+        pShared->bestCost = pTask->cost;
+        memcpy(pShared->bestOrder, pTask->order, sizeof(pShared->bestOrder));
+        __atomic_store_n(&pShared->bound, pTask->cost, __ATOMIC_RELAXED);
+    }
+
+    pthread_mutex_unlock(&pShared->lock);
+}
+
+/**
+ * @brief       Table Seen
+ * @details     This internal method is used to look up the set of the placed vertices in the table of the expanded
+ *              sets. If it was expanded with a cost which is not higher, the prefix is not needed. Otherwise the
+ *              prefix is entered, it replaces whatever was in the entry.
+ *
+ * @param       pShared     Pointer to the state of all workers
+ * @param       pTask       Pointer to the task
+ *
+ * @return      true if the same set was expanded with a cost which is not higher
+ */
+static bool table_seen(bnb_shared_t* pShared, const bnb_task_t* pTask)
+{
+    bnb_entry_t* pEntry = &pShared->pTable[(pTask->placed * 0x9E3779B97F4A7C15ULL) >> (64U - BNB_TABLE_BITS)];
+    bool seen = false;
+
+    if (0U != __atomic_exchange_n(&pEntry->lock, 1U, __ATOMIC_ACQUIRE))
+    {
+        return false;
+    }
+
+    seen = (0U != pEntry->cost) && (pTask->placed == pEntry->placed) && (pEntry->cost <= pTask->cost + 1U);
+
+    if (false == seen)
+    {
+        pEntry->placed = pTask->placed;
+        pEntry->cost = pTask->cost + 1U;
+    }
+
+    __atomic_store_n(&pEntry->lock, 0U, __ATOMIC_RELEASE);
+
+    return seen;
+}
+
+/**
+ * @brief       Pack Cycles
+ * @details     This internal method is used to pack edge-disjoint cycles into the vertices which are not placed.
+ *              Every order has at least one back edge on each of them. The 2-cycles are taken first, then every vertex
+ *              packs shortest cycles through itself, found by a breadth-first search on the successor masks. The path
+ *              back is taken from the levels of the search.
+ *              The cycles through every vertex are counted, a vertex which gets placed next can only break those.
+ *
+ * @param       pShared     Pointer to the state of all workers
+ * @param       rest        Vertices which are not placed
+ * @param       pThrough    Pointer to the number of packed cycles through every vertex (write)
+ *
+ * @return      Number of packed cycles
+ */
+static uint32_t pack_cycles(const bnb_shared_t* pShared, uint64_t rest, uint32_t pThrough[])
+{
+    uint64_t avail[BNB_MAX_VERT];
+    uint64_t level[BNB_MAX_VERT];
+    uint32_t cycles = 0U;
+
+    for (uint64_t left = rest; 0U != left; left &= left - 1U)
+    {
+        uint32_t v = (uint32_t)__builtin_ctzll(left);
+
+        avail[v] = pShared->out[v] & rest;
+        pThrough[v] = 0U;
+    }
+
+    for (uint64_t left = rest; 0U != left; left &= left - 1U)
+    {
+        uint32_t v = (uint32_t)__builtin_ctzll(left);
+
+        for (uint64_t pair = pShared->mutual[v] & rest; 0U != pair; pair &= pair - 1U)
+        {
+            uint32_t w = (uint32_t)__builtin_ctzll(pair);
+
+            avail[v] &= ~(1ULL << w);
+            avail[w] &= ~(1ULL << v);
+            pThrough[v]++;
+            pThrough[w]++;
+            cycles++;
+        }
+    }
+
+    for (uint64_t left = rest; 0U != left; left &= left - 1U)
+    {
+        uint32_t start = (uint32_t)__builtin_ctzll(left);
+        bool found = true;
+
+        while (found)
+        {
+            uint64_t seen = 1ULL << start;
+            uint64_t frontier = seen;
+            uint32_t depth = 0U;
+            uint32_t last = 0U;
+
+            found = false;
+
+            while ((0U != frontier) && (false == found))
+            {
+                uint64_t next = 0U;
+
+                level[depth++] = frontier;
+
+                for (uint64_t f = frontier; 0U != f; f &= f - 1U)
+                {
+                    uint32_t u = (uint32_t)__builtin_ctzll(f);
+
+                    if (0U != (avail[u] & (1ULL << start)))
+                    {
+                        found = true;
+                        last = u;
+                        break;
+                    }
+                    next |= avail[u];
+                }
+
+                frontier = next & ~seen;
+                seen |= next;
+            }
+
+            if (false == found)
+            {
+                break;
+            }
+
+            // the edge back to the start, then the path of the search backwards
+            avail[last] &= ~(1ULL << start);
+            pThrough[last]++;
+
+            for (uint32_t k = depth - 1U; 0U < k; k--)
+            {
+                for (uint64_t f = level[k - 1U]; 0U != f; f &= f - 1U)
+                {
+                    uint32_t p = (uint32_t)__builtin_ctzll(f);
+
+                    if (0U != (avail[p] & (1ULL << last)))
+                    {
+                        avail[p] &= ~(1ULL << last);
+                        pThrough[p]++;
+                        last = p;
+                        break;
+                    }
+                }
+            }
+
+            cycles++;
+        }
+    }
+
+    return cycles;
+}
+
+/**
+ * @brief       Expand
+ * @details     This internal method is used to branch on the next vertex of the order.
+ *              A source of the vertices which are left goes next without branching, no other choice can be better.
+ *              A prefix whose set of vertices was expanded with a cost which is not higher is dropped.
+ *              The lower bound of a prefix is its cost, the edges from the rest to the placed vertices (they are back
+ *              edges whatever comes next) and one edge of every cycle of a packing of the rest.
+ *              Placing v next adds its edges from the rest to the bound, but breaks the packed cycles through it, so
+ *              the bound of every child is known without expanding it. The children are pushed with the worst bound
+ *              first, so the owner continues with the most promising one and thieves take the others.
+ *              A child which does not fit into the deque is expanded in place.
+ *
+ * @param       pWorker     Pointer to the worker
+ * @param       pTask       Pointer to the task (gets changed)
+ */
+static void expand(bnb_worker_t* pWorker, bnb_task_t* pTask)
+{
+    bnb_shared_t* pShared = pWorker->pShared;
+    uint64_t rest = pShared->all & ~pTask->placed;
+    uint32_t lower = 0U;
+    uint32_t bound = 0U;
+    uint32_t childCnt = 0U;
+    uint32_t childVert[BNB_MAX_VERT];
+    uint32_t childAdd[BNB_MAX_VERT];
+    uint32_t through[BNB_MAX_VERT];
+    bool forced = true;
+
+    pWorker->nodes++;
+
+    if ((0U == (pWorker->nodes % BNB_CHECK_NODES)) ? check_abort(pShared, BNB_CHECK_NODES)
+                                                    : __atomic_load_n(&pShared->aborted, __ATOMIC_RELAXED))
+    {
+        return;
+    }
+
+    while (forced)
+    {
+        forced = false;
+
+        for (uint64_t left = rest; 0U != left; left &= left - 1U)
+        {
+            uint32_t v = (uint32_t)__builtin_ctzll(left);
+
+            if (0U == (pShared->in[v] & rest))
+            {
+                place(pShared, pTask, v);
+                rest &= ~(1ULL << v);
+                forced = true;
+            }
+        }
+    }
+
+    bound = search_bound(pShared);
+
+    if (pTask->cost >= bound)
+    {
+        return;
+    }
+
+    if (0U == rest)
+    {
+        report(pShared, pTask);
+        return;
+    }
+
+    lower = pTask->cost;
+    for (uint64_t left = rest; 0U != left; left &= left - 1U)
+    {
+        lower += (uint32_t)__builtin_popcountll(pShared->out[__builtin_ctzll(left)] & pTask->placed);
+    }
+
+    if ((lower >= bound) || table_seen(pShared, pTask))
+    {
+        return;
+    }
+
+    lower += pack_cycles(pShared, rest, through);
+
+    if (lower >= bound)
+    {
+        return;
+    }
+
+    // children sorted by their bound, the worst first (insertion sort, there are at most BNB_MAX_VERT)
+    for (uint64_t left = rest; 0U != left; left &= left - 1U)
+    {
+        uint32_t v = (uint32_t)__builtin_ctzll(left);
+        uint32_t add = (uint32_t)__builtin_popcountll(pShared->in[v] & rest) - through[v];
+        uint32_t pos = childCnt;
+
+        if ((lower + add) >= bound)
+        {
+            continue;
+        }
+
+        for (; (0U < pos) && (childAdd[pos - 1U] < add); pos--)
+        {
+            childAdd[pos] = childAdd[pos - 1U];
+            childVert[pos] = childVert[pos - 1U];
+        }
+
+        childAdd[pos] = add;
+        childVert[pos] = v;
+        childCnt++;
+    }
+
+    for (uint32_t i = 0U; i < childCnt; i++)
+    {
+        bnb_task_t child = *pTask;
+
+        place(pShared, &child, childVert[i]);
+
+        if (false == deque_push(&pShared->pDeques[pWorker->id], &child))
+        {
+            expand(pWorker, &child);
+        }
+    }
+}
+
+/**
+ * @brief       Steal Any
+ * @details     This internal method is used by an idle worker to look for a task in the deques of the others,
+ *              starting with its neighbour, so the thieves do not all go for the same deque.
+ *
+ * @param       pWorker     Pointer to the worker
+ * @param       pTask       Pointer to the task (write)
+ *
+ * @return      true if a task was taken
+ */
+static bool steal_any(bnb_worker_t* pWorker, bnb_task_t* pTask)
+{
+    bnb_shared_t* pShared = pWorker->pShared;
+
+    for (size_t i = 1U; i < pShared->threadCnt; i++)
+    {
+        if (deque_steal(&pShared->pDeques[(pWorker->id + i) % pShared->threadCnt], pTask))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief       Worker Main
+ * @details     This internal method is the loop of every worker. It works off its own deque first. If that is empty,
+ *              it gets idle and steals. A thief counts itself as busy before it tries to steal, so no task is ever
+ *              held by a worker which is not counted. If no worker is busy, no task is left anywhere and the search
+ *              is complete.
+ *
+ * @param       pArg        Pointer to the worker
+ *
+ * @return      NULL
+ */
+static void* worker_main(void* pArg)
+{
+    bnb_worker_t* pWorker = pArg;
+    bnb_shared_t* pShared = pWorker->pShared;
+    bnb_task_t task;
+    size_t idleRounds = 0U;
+
+    while (false == __atomic_load_n(&pShared->aborted, __ATOMIC_RELAXED))
+    {
+        if (deque_pop(&pShared->pDeques[pWorker->id], &task))
+        {
+            expand(pWorker, &task);
+            continue;
+        }
+
+        __atomic_fetch_sub(&pShared->busy, 1, __ATOMIC_SEQ_CST);
+
+        while (true)
+        {
+            if (check_abort(pShared, 0U))
+            {
+                return NULL;
+            }
+
+            __atomic_fetch_add(&pShared->busy, 1, __ATOMIC_SEQ_CST);
+
+            if (steal_any(pWorker, &task))
+            {
+                idleRounds = 0U;
+                expand(pWorker, &task);
+                break;
+            }
+
+            if (0 == __atomic_sub_fetch(&pShared->busy, 1, __ATOMIC_SEQ_CST))
+            {
+                return NULL;
+            }
+
+            circular_buffer_backoff(&idleRounds);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief       Branch and Bound
+ * @details     This method is used to find a vertex order with the fewest back edges, like exact_order, for graphs
+ *              which are too big for the dynamic program. The orders are built from the front and every prefix is
+ *              pruned as soon as its lower bound reaches the best order of the workers or goes above the incumbent.
+ *              A good incumbent (the best random solution) cuts most of the tree right away, the random search is
+ *              its warm start. The vertex sets which were expanded are kept in a table, so a set is not searched
+ *              again in another order. The search gives up after the node budget of the problem.
+ *              The subtrees are balanced with one work-stealing deque per worker. The calling thread is the first
+ *              worker, if threads cannot be started it works with fewer.
+ *              An order is returned only if the whole tree was searched, so it is a minimum. If nothing below or
+ *              equal to the incumbent was found, the incumbent is minimal already.
+ *
+ * @param       pProb       Pointer to the problem
+ * @param       pVert       Pointer to the order of the vertices (write, vertCnt elements)
+ * @param       pCost       Pointer to the number of back edges of the order (write)
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine, the order is minimal
+ * @retval      ERROR_PARAM     Too many vertices (or too many edges for the costs)
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ * @retval      ERROR_LIMIT     The search was aborted, or the incumbent cannot be improved
+ */
+error_t bnb_solve(const bnb_problem_t* pProb, vertex_t* pVert, size_t* pCost)
+{
+    error_t retCode = ERROR_OK;
+    bnb_shared_t* pShared = NULL;
+    bnb_worker_t* pWorkers = NULL;
+    bnb_task_t root = {0};
+    size_t threadCnt = (0U < pProb->threadCnt) ? pProb->threadCnt : 1U;
+
+    if ((BNB_MAX_VERT < pProb->vertCnt) || (UINT32_MAX <= pProb->pSoa->edgeCnt))
+    {
+        return ERROR_PARAM;
+    }
+
+    if (0 != posix_memalign((void**)&pShared, CACHE_LINE_SIZE, sizeof(bnb_shared_t)))
+    {
+        return ERROR_NULLPTR;
+    }
+
+    memset(pShared, 0, sizeof(bnb_shared_t));
+    pShared->pProb = pProb;
+    pShared->threadCnt = threadCnt;
+    pShared->bound = UINT32_MAX;
+    pShared->all = (BNB_MAX_VERT == pProb->vertCnt) ? UINT64_MAX : ((1ULL << pProb->vertCnt) - 1U);
+
+    for (size_t i = 0U; i < pProb->pSoa->edgeCnt; i++)
+    {
+        pShared->out[pProb->pSoa->pStart[i]] |= 1ULL << pProb->pSoa->pEnd[i];
+        pShared->in[pProb->pSoa->pEnd[i]] |= 1ULL << pProb->pSoa->pStart[i];
+    }
+
+    for (size_t v = 0U; v < pProb->vertCnt; v++)
+    {
+        pShared->mutual[v] = pShared->out[v] & pShared->in[v] & ~((2ULL << v) - 1U);
+    }
+
+    pWorkers = calloc(threadCnt, sizeof(bnb_worker_t));
+    pShared->pTable = calloc((size_t)1U << BNB_TABLE_BITS, sizeof(bnb_entry_t));
+
+    if ((NULL == pWorkers) || (NULL == pShared->pTable) ||
+        (0 != posix_memalign((void**)&pShared->pDeques, CACHE_LINE_SIZE, sizeof(bnb_deque_t) * threadCnt)))
+    {
+        free(pShared->pTable);
+        free(pWorkers);
+        free(pShared);
+        return ERROR_NULLPTR;
+    }
+
+    memset(pShared->pDeques, 0, sizeof(bnb_deque_t) * threadCnt);
+
+    for (size_t i = 0U; i < threadCnt; i++)
+    {
+        pWorkers[i].pShared = pShared;
+        pWorkers[i].id = i;
+        pShared->pDeques[i].pTasks = malloc(sizeof(bnb_task_t) * BNB_DEQUE_SIZE);
+
+        if (NULL == pShared->pDeques[i].pTasks)
+        {
+            retCode |= ERROR_NULLPTR;
+        }
+    }
+
+    if (ERROR_OK == retCode)
+    {
+        pthread_mutex_init(&pShared->lock, NULL);
+        deque_push(&pShared->pDeques[0], &root);
+        pShared->busy = 1;
+
+        // a worker is busy from its start, until it finds its deque empty
+        for (size_t i = 1U; i < threadCnt; i++)
+        {
+            __atomic_fetch_add(&pShared->busy, 1, __ATOMIC_SEQ_CST);
+            pWorkers[i].started = (0 == pthread_create(&pWorkers[i].thread, NULL, worker_main, &pWorkers[i]));
+
+            if (false == pWorkers[i].started)
+            {
+                __atomic_fetch_sub(&pShared->busy, 1, __ATOMIC_SEQ_CST);
+            }
+        }
+
+        worker_main(&pWorkers[0]);
+
+        for (size_t i = 1U; i < threadCnt; i++)
+        {
+            if (pWorkers[i].started)
+            {
+                pthread_join(pWorkers[i].thread, NULL);
+            }
+        }
+
+        pthread_mutex_destroy(&pShared->lock);
+
+        if (pShared->aborted || (false == pShared->found))
+        {
+            retCode |= ERROR_LIMIT;
+        }
+        else
+        {
+            for (size_t i = 0U; i < pProb->vertCnt; i++)
+            {
+                pVert[i] = (vertex_t)pShared->bestOrder[i];
+            }
+            *pCost = pShared->bestCost;
+        }
+    }
+
+    for (size_t i = 0U; i < threadCnt; i++)
+    {
+        free(pShared->pDeques[i].pTasks);
+    }
+    free(pShared->pDeques);
+    free(pShared->pTable);
+    free(pWorkers);
+    free(pShared);
+
+    return retCode;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+/**
+ * @file  bnb.h
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ * @brief Exact minimum feedback arc set of medium graphs (parallel branch and bound over the vertex orders)
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "backedges.h"
+#include "common.h"
+#include "errors.h"
+
+#define BNB_MAX_VERT 64U     /*!< Biggest number of vertices the branch and bound takes (one 64 bit mask per set) */
+#define BNB_DEQUE_SIZE 4096U /*!< Tasks in the deque of every worker (power of two), more are expanded in place */
+#define BNB_CHECK_NODES 1024U /*!< Nodes expanded by a worker before it looks at the abort flags again */
+#define BNB_TABLE_BITS 20U    /*!< The table of the expanded vertex sets has 2^BNB_TABLE_BITS entries (16 byte each) */
+#define BNB_NODE_BUDGET (1ULL << 20) /*!< Nodes after which a generator gives up on a component (seconds of one core) */
+
+/*!
+ * @struct bnb_problem_t
+ * @brief  Problem of the branch and bound
+ *
+ * @details The incumbent is the size of the best solution known elsewhere (the best random solution the supervisor
+ *          got), only smaller solutions are searched. It is read again while the search runs, so solutions which are
+ *          found in the meantime prune the search as well. The search is aborted as soon as the generators should
+ *          stop, the component is solved by someone else or the node budget is used up.
+ **/
+typedef struct
+{
+    const edge_soa_t* pSoa;   /*!< edges of the graph (local ids, no loops, no parallel edges) */
+    size_t vertCnt;           /*!< number of vertices, at most BNB_MAX_VERT */
+    size_t threadCnt;         /*!< number of workers, including the calling thread */
+    const size_t* pIncumbent; /*!< size of the best known solution (atomic, SIZE_MAX if none), or NULL */
+    const bool* pActive;      /*!< search goes on while this is set (atomic), or NULL */
+    const bool* pSolved;      /*!< search stops if this gets set (atomic), or NULL */
+    uint64_t nodeBudget;      /*!< search stops after this many nodes of all workers, 0 for no limit */
+} bnb_problem_t;
+
+/* **** FUNCTIONS **** */
+error_t bnb_solve(const bnb_problem_t* pProb, vertex_t* pVert, size_t* pCost);
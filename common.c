@@ -1,9 +1,11 @@
 #include "common.h"
 
 #include <assert.h>
+#include <sched.h>
 #include <semaphore.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 
 #include "errors.h"
 
@@ -37,141 +39,790 @@ void emit_error(char* msg, error_t retCode)
     exit(EXIT_FAILURE);
 }
 
+/**
+ * @brief       Sequence Bytes
+ * @details     This internal method is used to get the size of the sequence numbers of a circular buffer, padded to
+ *              a whole cache line so the cells start on their own line.
+ *
+ * @param       cellCnt     Number of cells of the circular buffer
+ *
+ * @return      Size in byte
+*/
+static size_t seq_bytes(size_t cellCnt)
+{
+    return ((sizeof(size_t) * cellCnt) + CACHE_LINE_SIZE - 1U) & ~((size_t)CACHE_LINE_SIZE - 1U);
+}
+
+/**
+ * @brief       Ring Size
+ * @details     This internal method is used to get the size of one circular buffer with its sequence numbers and
+ *              cells.
+ *
+ * @param       cellCnt     Number of cells of the circular buffer
+ *
+ * @return      Size in byte
+*/
+static size_t ring_size(size_t cellCnt)
+{
+    return sizeof(shared_mem_circbuf_t) + seq_bytes(cellCnt) + (cellCnt * CIRBUF_CELL_SIZE);
+}
+
+/**
+ * @brief       Ring Sequence Numbers
+ * @details     This internal method is used to get the sequence numbers which follow the circular buffer.
+ *
+ * @param       pCirBuf     Pointer to the circular buffer
+ *
+ * @return      Pointer to the first sequence number
+*/
+static size_t* ring_seq(const shared_mem_circbuf_t* pCirBuf)
+{
+    return (size_t*)((uintptr_t)pCirBuf + sizeof(shared_mem_circbuf_t));
+}
+
+/**
+ * @brief       Ring Cells
+ * @details     This internal method is used to get the cells which follow the sequence numbers of the circular buffer.
+ *
+ * @param       pCirBuf     Pointer to the circular buffer
+ *
+ * @return      Pointer to the first byte of the first cell
+*/
+static uint8_t* ring_cells(const shared_mem_circbuf_t* pCirBuf)
+{
+    return (uint8_t*)((uintptr_t)pCirBuf + sizeof(shared_mem_circbuf_t) + seq_bytes(pCirBuf->cellCnt));
+}
+
+/**
+ * @brief       Shared Memory Size
+ * @details     This method is used to get the size of the shared memory with all circular buffers.
+ *
+ * @param       cellCnt     Number of cells of every circular buffer
+ *
+ * @return      Size in byte
+*/
+size_t shared_mem_size(size_t cellCnt)
+{
+    return sizeof(shared_mem_t) + (CIRBUF_RING_CNT * ring_size(cellCnt));
+}
+
+/**
+ * @brief       Shared Memory Init
+ * @details     This method is used to reset the shared memory, to record its layout in the header and to bring all
+ *              circular buffers into their initial state. It has to be called by the supervisor before the generators
+ *              are started.
+ *
+ * @param       pSharedMem  Pointer to the shared memory
+ * @param       cellCnt     Number of cells of every circular buffer (power of two)
+ * @param       size        Size of the mapping, at least shared_mem_size(cellCnt)
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_NULLPTR   The pointer was NULL
+ * @retval      ERROR_PARAM     The number of cells is no power of two or the size is too small
+*/
+error_t shared_mem_init(shared_mem_t* pSharedMem, size_t cellCnt, size_t size)
+{
+    error_t retCode = ERROR_OK;
+
+    if (NULL == pSharedMem)
+    {
+        return ERROR_NULLPTR;
+    }
+
+    if ((0U == cellCnt) || (0U != (cellCnt & (cellCnt - 1U))) || (shared_mem_size(cellCnt) > size))
+    {
+        return ERROR_PARAM;
+    }
+
+    memset(pSharedMem, 0, size);
+    pSharedMem->size = size;
+    pSharedMem->cellCnt = cellCnt;
+    pSharedMem->ringSize = ring_size(cellCnt);
+
+    for (size_t i = 0U; i < SHAREDMEM_COMP_CNT; i++)
+    {
+        pSharedMem->compBest[i] = SIZE_MAX;
+    }
+
+    for (size_t i = 0U; i < CIRBUF_RING_CNT; i++)
+    {
+        retCode |= circular_buffer_init(shared_mem_ring(pSharedMem, i), cellCnt);
+    }
+
+    return retCode;
+}
+
+/**
+ * @brief       Shared Memory Ring
+ * @details     This method is used to get a circular buffer of the shared memory.
+ *
+ * @param       pSharedMem  Pointer to the shared memory
+ * @param       ring        Index of the circular buffer (the lane), has to be smaller than CIRBUF_RING_CNT
+ *
+ * @return      Pointer to the circular buffer
+*/
+shared_mem_circbuf_t* shared_mem_ring(shared_mem_t* pSharedMem, size_t ring)
+{
+    return (shared_mem_circbuf_t*)((uintptr_t)pSharedMem + sizeof(shared_mem_t) + (ring * pSharedMem->ringSize));
+}
+
+/**
+ * @brief       Circular Buffer Init
+ * @details     This method is used to bring a (zeroed) circular buffer into its initial state.
+ *              The sequence number of every cell is set to its index, which marks it as free for the first round
+ *              of the lock-free ring. The semaphore version only needs the indexes to be reset.
+ *
+ * @param       pCirBuf     Pointer to the circular buffer, followed by the memory of its cells
+ * @param       cellCnt     Number of cells (power of two)
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_NULLPTR   The pointer was NULL
+*/
+error_t circular_buffer_init(shared_mem_circbuf_t* pCirBuf, size_t cellCnt)
+{
+    size_t* pSeq = NULL;
+
+    if (NULL == pCirBuf)
+    {
+        return ERROR_NULLPTR;
+    }
+
+    pCirBuf->cellCnt = cellCnt;
+    pCirBuf->mask = cellCnt - 1U;
+    pCirBuf->head = 0U;
+    pCirBuf->tail = 0U;
+    pCirBuf->tailCache = 0U;
+    pCirBuf->headCache = 0U;
+    pCirBuf->claimed = false;
+
+    pSeq = ring_seq(pCirBuf);
+    for (size_t i = 0U; i < cellCnt; i++)
+    {
+        pSeq[i] = i;
+    }
+
+    return ERROR_OK;
+}
+
+/**
+ * @brief       Circular Buffer Backoff
+ * @details     This method is used to wait a bit if the lock-free ring is full (writer) or empty (reader).
+ *              The first rounds only give up the time slice, after that the caller is put to sleep for a short time,
+ *              so that a waiting process does not burn a whole core.
+ *
+ * @param       pRound      Pointer to the number of rounds the caller has already waited (gets increased)
+*/
+void circular_buffer_backoff(size_t* pRound)
+{
+    const struct timespec delay = {.tv_sec = 0, .tv_nsec = 100000L}; /*!< 100us */
+
+    if (*pRound < 16U)
+    {
+        sched_yield();
+    }
+    else
+    {
+        nanosleep(&delay, NULL);
+    }
+
+    (*pRound)++;
+}
+
+/**
+ * @brief       Circular Buffer Attach
+ * @details     This method is used by a generator to get the circular buffer it has to write to.
+ *              If built with CIRBUF_LANES a free lane gets claimed atomically, so that every generator owns its own
+ *              single-producer lane. Otherwise all generators share the one circular buffer.
+ *
+ * @param       pSharedMem  Pointer to the shared memory
+ * @param       ppCirBuf    Pointer where the address of the circular buffer gets written to
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_NULLPTR   One of the pointers was NULL
+ * @retval      ERROR_LIMIT     All lanes are already claimed
+*/
+error_t circular_buffer_attach(shared_mem_t* pSharedMem, shared_mem_circbuf_t** ppCirBuf)
+{
+    if ((NULL == pSharedMem) || (NULL == ppCirBuf))
+    {
+        return ERROR_NULLPTR;
+    }
+
+#ifdef CIRBUF_LANES
+    for (size_t i = 0U; i < CIRBUF_LANE_CNT; i++)
+    {
+        shared_mem_circbuf_t* pLane = shared_mem_ring(pSharedMem, i);
+        bool expected = false;
+
+        if (__atomic_compare_exchange_n(&pLane->claimed, &expected, true, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            *ppCirBuf = pLane;
+            return ERROR_OK;
+        }
+    }
+
+    return ERROR_LIMIT;
+#else
+    *ppCirBuf = shared_mem_ring(pSharedMem, 0U);
+    return ERROR_OK;
+#endif
+}
+
+/**
+ * @brief       Circular Buffer Detach
+ * @details     This method is used by a generator to give back its circular buffer when terminating.
+ *              With CIRBUF_LANES the lane can be claimed by a new generator afterwards, the not yet read solutions
+ *              stay in the lane. Otherwise nothing has to be done.
+ *
+ * @param       pCirBuf     Pointer to the circular buffer
+*/
+void circular_buffer_detach(shared_mem_circbuf_t* pCirBuf)
+{
+    if (NULL != pCirBuf)
+    {
+        __atomic_store_n(&pCirBuf->claimed, false, __ATOMIC_RELEASE);
+    }
+}
+
+/**
+ * @brief       Record Cells
+ * @details     This internal method is used to get the number of cells a record needs (header and edges, padded to
+ *              whole cells).
+ *
+ * @param       edgeCnt     Number of edges of the solution
+ *
+ * @return      Number of cells
+*/
+static size_t record_cells(size_t edgeCnt)
+{
+    return CIRBUF_RECORD_CELLS(edgeCnt);
+}
+
+/**
+ * @brief       Record Store
+ * @details     This internal method is used to write a record into the cells starting at the given one.
+ *              The header never wraps, because it is at the start of a cell. The edges are copied with one memcpy,
+ *              or two if they wrap around at the end of the buffer.
+ *
+ * @param       pCirBuf     Pointer to the circular buffer
+ * @param       first       Index (or position) of the first cell of the record
+ * @param       pHdr        Pointer to the header of the record
+ * @param       pEdges      Pointer to the edges of the solution
+*/
+static void record_store(shared_mem_circbuf_t* pCirBuf, size_t first, const record_header_t* pHdr,
+                         const edge_t* pEdges)
+{
+    uint8_t* pBase = ring_cells(pCirBuf);
+    size_t ringBytes = pCirBuf->cellCnt * CIRBUF_CELL_SIZE;
+    size_t cell = first & pCirBuf->mask;
+    size_t offset = ((cell * CIRBUF_CELL_SIZE) + sizeof(record_header_t)) % ringBytes;
+    size_t len = sizeof(edge_t) * pHdr->edgeCnt;
+    size_t part = ((ringBytes - offset) < len) ? (ringBytes - offset) : len;
+
+    memcpy(pBase + (cell * CIRBUF_CELL_SIZE), pHdr, sizeof(record_header_t));
+
+    if (0U < len)
+    {
+        memcpy(pBase + offset, pEdges, part);
+        memcpy(pBase, (const uint8_t*)pEdges + part, len - part);
+    }
+}
+
+/**
+ * @brief       Record Header
+ * @details     This internal method is used to read the header of the record starting at the given cell.
+ *
+ * @param       pCirBuf     Pointer to the circular buffer
+ * @param       first       Index (or position) of the first cell of the record
+ * @param       pHdr        Pointer where the header gets written to
+*/
+static void record_header(const shared_mem_circbuf_t* pCirBuf, size_t first, record_header_t* pHdr)
+{
+    memcpy(pHdr, ring_cells(pCirBuf) + ((first & pCirBuf->mask) * CIRBUF_CELL_SIZE), sizeof(record_header_t));
+}
+
+/**
+ * @brief       Record Load
+ * @details     This internal method is used to copy the edges of the record starting at the given cell.
+ *              It is the mirror of record_store.
+ *
+ * @param       pCirBuf     Pointer to the circular buffer
+ * @param       first       Index (or position) of the first cell of the record
+ * @param       pEdges      Pointer to the result array
+ * @param       edgeCnt     Number of edges of the record
+*/
+static void record_load(const shared_mem_circbuf_t* pCirBuf, size_t first, edge_t* pEdges, size_t edgeCnt)
+{
+    const uint8_t* pBase = ring_cells(pCirBuf);
+    size_t ringBytes = pCirBuf->cellCnt * CIRBUF_CELL_SIZE;
+    size_t offset = (((first & pCirBuf->mask) * CIRBUF_CELL_SIZE) + sizeof(record_header_t)) % ringBytes;
+    size_t len = sizeof(edge_t) * edgeCnt;
+    size_t part = ((ringBytes - offset) < len) ? (ringBytes - offset) : len;
+
+    memcpy(pEdges, pBase + offset, part);
+    memcpy((uint8_t*)pEdges + part, pBase, len - part);
+}
+
+#if !defined(CIRBUF_NONBLOCKING)
+
 /**
  * @brief       Safe Increase
  *              This method is used to increase the index of the circular buffer but without the risk of an overflow.
+ * @param       pCirBuf     Pointer to the circular buffer
  * @param       pIndex      Pointer to the index which should be increased
+ * @param       cnt         Number of cells the index is increased by
+*/
+static void circular_buffer_safeIncrease(const shared_mem_circbuf_t* pCirBuf, size_t* pIndex, size_t cnt)
+{
+    *pIndex = (*pIndex + cnt) & pCirBuf->mask;
+}
+
+/**
+ * @brief       Semaphore Error
+ * @details     This internal method is used to map the errno of a failed semaphore operation to an error code.
+ *
+ * @return      ERROR_SIGINT if interrupted by a signal, else ERROR_SEMAPHORE
 */
-static void circular_buffer_safeIncrease(ssize_t* pIndex) { *pIndex = (*pIndex + 1U) % CIRBUF_BUFSIZE; }
+static error_t semaphore_error(void) { return (errno == EINTR) ? ERROR_SIGINT : ERROR_SEMAPHORE; }
 
 /**
  * @brief       Circular Buffer Read
- * @details     This method is used to read an element from the circular buffer. It will wait until an element is
- *             available to read and then copy it to the result address.
+ * @details     This method is used to read a whole record from the circular buffer. It will wait until a record is
+ *              available to read (at most CIRBUF_READ_TIMEOUT_MS) and then copy its header and edges to the result
+ *              addresses. Only one semaphore wait is needed for a record, no matter how many cells it uses; every
+ *              cell is given back to the writers afterwards.
+ *              If the edges do not fit into the result array, the record stays in the buffer and only its header is
+ *              returned, so the caller can grow the array and read again.
  * 
  * @param       pCirBuf     Pointer to the circular buffer
  * @param       pSems       Pointer to the semaphores
- * @param       pResult     Pointer to the result address
+ * @param       pHdr        Pointer where the header of the record gets written to
+ * @param       pEdges      Pointer to the result array
+ * @param       maxEdges    Number of edges the result array can hold
  * 
  * @return      Error code
- * @retval      ERROR_OK        Everything went fine
- * @retval      ERROR_NULLPTR   One of the pointers was NULL
- * @retval      ERROR_SIGINT    The process was interrupted by a signal
- * @retval      ERROR_SEMAPHORE The semaphore could not be accessed
+ * @retval      ERROR_OK            Everything went fine
+ * @retval      ERROR_NULLPTR       One of the pointers was NULL
+ * @retval      ERROR_LIMIT         The result array is too small, the header holds the needed size
+ * @retval      ERROR_CIRBUF_EMPTY  Nothing was written within the timeout
+ * @retval      ERROR_SIGINT        The process was interrupted by a signal
+ * @retval      ERROR_SEMAPHORE     The semaphore could not be accessed
 */
-error_t circular_buffer_read(shared_mem_circbuf_t* pCirBuf, sems_t* pSems, edge_t* pResult)
+error_t circular_buffer_read(shared_mem_circbuf_t* pCirBuf, sems_t* pSems, record_header_t* pHdr, edge_t* pEdges,
+                             size_t maxEdges)
 {
     error_t retCode = ERROR_OK;
+    struct timespec timeout = {0};
+    size_t cells = 0U;
 
     // check if all pointer are valid
-    if ((NULL == pCirBuf) || (NULL == pSems) || (NULL == pResult))
+    if ((NULL == pCirBuf) || (NULL == pSems) || (NULL == pHdr) || (NULL == pEdges))
     {
         return ERROR_NULLPTR;
     }
 
     // cannot read if buffer is empty, so check if the buffer has elements
-    if (sem_wait(pSems->reading) < 0)
+    // the wait is limited, so that the caller can check its termination conditions even if nothing gets written
+    clock_gettime(CLOCK_REALTIME, &timeout);
+    timeout.tv_nsec += CIRBUF_READ_TIMEOUT_MS * 1000000L;
+    timeout.tv_sec += timeout.tv_nsec / 1000000000L;
+    timeout.tv_nsec %= 1000000000L;
+
+    if (sem_timedwait(pSems->reading, &timeout) < 0)
     {
-        if (errno == EINTR)
-        {
-            return ERROR_SIGINT;
-        }
-        else
-        {
-            return ERROR_SEMAPHORE;
-        }
+        return (errno == ETIMEDOUT) ? ERROR_CIRBUF_EMPTY : semaphore_error();
     } 
 
-    // copy the element from the buffer to the result address
-    memcpy(pResult, &pCirBuf->buf[pCirBuf->tail], sizeof(edge_t));
-    circular_buffer_safeIncrease(&pCirBuf->tail);
+    record_header(pCirBuf, pCirBuf->tail, pHdr);
+
+    if (pHdr->edgeCnt > maxEdges)
+    {
+        // leave the record where it is
+        return (sem_post(pSems->reading) < 0) ? semaphore_error() : ERROR_LIMIT;
+    }
+
+    // copy the solution from the record to the result address
+    record_load(pCirBuf, pCirBuf->tail, pEdges, pHdr->edgeCnt);
+    cells = record_cells(pHdr->edgeCnt);
+    circular_buffer_safeIncrease(pCirBuf, &pCirBuf->tail, cells);
 
     // something was read, so the fullness decreases
-    if (sem_post(pSems->writing) < 0)
+    for (size_t i = 0U; i < cells; i++)
     {
-        if (errno == EINTR)
+        if (sem_post(pSems->writing) < 0)
         {
-            return ERROR_SIGINT;
+            return semaphore_error();
         }
-        else
-        {
-            return ERROR_SEMAPHORE;
-        }
-    } 
+    }
 
     return retCode;
 }
 
 /**
  * @brief       Circular Buffer Write
- * @details     This method is used to write an element to the circular buffer. It will wait until an element can be
- *              written and then copy it to the buffer.
+ * @details     This method is used to write a whole record to the circular buffer. It will wait until all cells of
+ *              the record can be written and then copy the header and the edges into them.
+ *
+ * @note        The caller has to ensure that only one writer is active at the same time (mutex), so the cells of a
+ *              record are consecutive.
  * 
  * @param       pCirBuf     Pointer to the circular buffer
  * @param       pSems       Pointer to the semaphores
- * @param       pEd         Pointer to the element which should be written
+ * @param       pHdr        Pointer to the header of the record (holds the number of edges)
+ * @param       pEdges      Pointer to the edges which should be written
  * 
  * @return      Error code
  * @retval      ERROR_OK        Everything went fine
  * @retval      ERROR_NULLPTR   One of the pointers was NULL
+ * @retval      ERROR_LIMIT     The solution is bigger than the whole buffer (CIRBUF_RECORD_MAX)
  * @retval      ERROR_SIGINT    The process was interrupted by a signal
  * @retval      ERROR_SEMAPHORE The semaphore could not be accessed
 */
-error_t circular_buffer_write(shared_mem_circbuf_t* pCirBuf, sems_t* pSems, edge_t* pEd)
+error_t circular_buffer_write(shared_mem_circbuf_t* pCirBuf, sems_t* pSems, const record_header_t* pHdr,
+                              const edge_t* pEdges)
 {
     error_t retCode = ERROR_OK;
+    size_t cells = 0U;
 
     // check if all pointer are valid
-    if ((NULL == pCirBuf) || (NULL == pSems) || (NULL == pEd))
+    if ((NULL == pCirBuf) || (NULL == pSems) || (NULL == pHdr) || ((NULL == pEdges) && (0U != pHdr->edgeCnt)))
     {
         return ERROR_NULLPTR;
     }
 
-    // mutex: only one generator is allowed to write at the same time
+    // a solution has to fit into the buffer
+    if (CIRBUF_RECORD_MAX(pCirBuf->cellCnt) < pHdr->edgeCnt)
+    {
+        return ERROR_LIMIT;
+    }
+
     // if the buffer is full, you have to wait until it gets read
-    if (sem_wait(pSems->writing) < 0)
+    cells = record_cells(pHdr->edgeCnt);
+    for (size_t i = 0U; i < cells; i++)
+    {
+        if (sem_wait(pSems->writing) < 0)
+        {
+            return semaphore_error();
+        }
+    }
+
+    // fill the record
+    record_store(pCirBuf, pCirBuf->head, pHdr, pEdges);
+    circular_buffer_safeIncrease(pCirBuf, &pCirBuf->head, cells);
+
+    // something was written into the buffer, so the supervisor can read something now
+    if (sem_post(pSems->reading) < 0)
+    {
+        return semaphore_error();
+    } 
+
+    assert(pCirBuf->head < pCirBuf->cellCnt && pCirBuf->tail < pCirBuf->cellCnt);
+
+    return retCode;
+}
+
+#elif defined(CIRBUF_LOCKFREE)
+
+/**
+ * @brief       Circular Buffer Read (lock-free)
+ * @details     This method is used to read a whole record from the lock-free circular buffer.
+ *              Every cell carries a sequence number (Vyukov MPMC ring): a record at position pos is ready to be read
+ *              if the sequence number of its first cell is pos + 1. The whole record is claimed at once by moving the
+ *              tail over all of its cells. After the copy every cell is released for the next round by setting its
+ *              sequence number to its position + the number of cells. The method does not block, so the caller has to
+ *              retry.
+ *              If the edges do not fit into the result array, the record stays in the buffer and only its header is
+ *              returned.
+ *
+ * @param       pCirBuf     Pointer to the circular buffer
+ * @param       pSems       Pointer to the semaphores (unused)
+ * @param       pHdr        Pointer where the header of the record gets written to
+ * @param       pEdges      Pointer to the result array
+ * @param       maxEdges    Number of edges the result array can hold
+ *
+ * @return      Error code
+ * @retval      ERROR_OK            Everything went fine
+ * @retval      ERROR_NULLPTR       One of the pointers was NULL
+ * @retval      ERROR_LIMIT         The result array is too small, the header holds the needed size
+ * @retval      ERROR_CIRBUF_EMPTY  There is nothing to read at the moment
+*/
+error_t circular_buffer_read(shared_mem_circbuf_t* pCirBuf, sems_t* pSems, record_header_t* pHdr, edge_t* pEdges,
+                             size_t maxEdges)
+{
+    size_t* pSeq = NULL;
+    size_t pos = 0U;
+    size_t seq = 0U;
+    size_t cells = 0U;
+    intptr_t diff = 0;
+
+    (void)pSems;
+
+    // check if all pointer are valid
+    if ((NULL == pCirBuf) || (NULL == pHdr) || (NULL == pEdges))
     {
-        if (errno == EINTR)
+        return ERROR_NULLPTR;
+    }
+
+    pSeq = ring_seq(pCirBuf);
+    pos = __atomic_load_n(&pCirBuf->tail, __ATOMIC_RELAXED);
+
+    while (true)
+    {
+        seq = __atomic_load_n(&pSeq[pos & pCirBuf->mask], __ATOMIC_ACQUIRE);
+        diff = (intptr_t)seq - (intptr_t)(pos + 1U);
+
+        if (0 == diff)
+        {
+            record_header(pCirBuf, pos, pHdr);
+
+            if (pHdr->edgeCnt > maxEdges)
+            {
+                return ERROR_LIMIT;
+            }
+
+            // record is published, try to claim all of its cells
+            cells = record_cells(pHdr->edgeCnt);
+            if (__atomic_compare_exchange_n(&pCirBuf->tail, &pos, pos + cells, false, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
         {
-            return ERROR_SIGINT;
+            // the writer has not published this record yet
+            return ERROR_CIRBUF_EMPTY;
         }
         else
         {
-            return ERROR_SEMAPHORE;
+            // another reader was faster, try again with the new tail
+            pos = __atomic_load_n(&pCirBuf->tail, __ATOMIC_RELAXED);
         }
-    } 
+    }
 
-    // set the element
-    memcpy(&pCirBuf->buf[pCirBuf->head], pEd, sizeof(edge_t));
-    circular_buffer_safeIncrease(&pCirBuf->head);
+    // copy the solution from the record to the result address
+    record_load(pCirBuf, pos, pEdges, pHdr->edgeCnt);
 
-    // something was written into the buffer, so the supervisor can read something now
-    if (sem_post(pSems->reading) < 0)
+    // release the cells for the next round
+    for (size_t i = 0U; i < cells; i++)
     {
-        if (errno == EINTR)
+        __atomic_store_n(&pSeq[(pos + i) & pCirBuf->mask], pos + i + pCirBuf->cellCnt, __ATOMIC_RELEASE);
+    }
+
+    return ERROR_OK;
+}
+
+/**
+ * @brief       Circular Buffer Write (lock-free)
+ * @details     This method is used to write a whole record to the lock-free circular buffer.
+ *              A cell at position pos is free if its sequence number is pos. The writer checks that all cells of the
+ *              record are free, reserves them by increasing the head with a compare-and-swap, fills them and
+ *              publishes the record by setting the sequence number of its first cell to pos + 1 (after the others).
+ *              No mutex is needed, so any number of writers can be active at the same time.
+ *              The method does not block, so the caller has to retry if the buffer is full.
+ *
+ * @param       pCirBuf     Pointer to the circular buffer
+ * @param       pSems       Pointer to the semaphores (unused)
+ * @param       pHdr        Pointer to the header of the record (holds the number of edges)
+ * @param       pEdges      Pointer to the edges which should be written
+ *
+ * @return      Error code
+ * @retval      ERROR_OK            Everything went fine
+ * @retval      ERROR_NULLPTR       One of the pointers was NULL
+ * @retval      ERROR_LIMIT         The solution is bigger than the whole buffer (CIRBUF_RECORD_MAX)
+ * @retval      ERROR_CIRBUF_FULL   There are not enough free cells at the moment
+*/
+error_t circular_buffer_write(shared_mem_circbuf_t* pCirBuf, sems_t* pSems, const record_header_t* pHdr,
+                              const edge_t* pEdges)
+{
+    size_t* pSeq = NULL;
+    size_t cells = 0U;
+    size_t pos = 0U;
+    intptr_t diff = 0;
+
+    (void)pSems;
+
+    // check if all pointer are valid
+    if ((NULL == pCirBuf) || (NULL == pHdr) || ((NULL == pEdges) && (0U != pHdr->edgeCnt)))
+    {
+        return ERROR_NULLPTR;
+    }
+
+    // a solution has to fit into the buffer
+    if (CIRBUF_RECORD_MAX(pCirBuf->cellCnt) < pHdr->edgeCnt)
+    {
+        return ERROR_LIMIT;
+    }
+
+    pSeq = ring_seq(pCirBuf);
+    cells = record_cells(pHdr->edgeCnt);
+    pos = __atomic_load_n(&pCirBuf->head, __ATOMIC_RELAXED);
+
+    while (true)
+    {
+        // every cell of the record has to be free for this round
+        diff = 0;
+        for (size_t i = 0U; (i < cells) && (0 == diff); i++)
+        {
+            size_t seq = __atomic_load_n(&pSeq[(pos + i) & pCirBuf->mask], __ATOMIC_ACQUIRE);
+            diff = (intptr_t)seq - (intptr_t)(pos + i);
+        }
+
+        if (0 == diff)
         {
-            return ERROR_SIGINT;
+            // cells are free, try to reserve them
+            if (__atomic_compare_exchange_n(&pCirBuf->head, &pos, pos + cells, false, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // the reader has not released a cell yet
+            return ERROR_CIRBUF_FULL;
         }
         else
         {
-            return ERROR_SEMAPHORE;
+            // another writer was faster, try again with the new head
+            pos = __atomic_load_n(&pCirBuf->head, __ATOMIC_RELAXED);
         }
-    } 
+    }
 
-    assert(pCirBuf->head < CIRBUF_BUFSIZE && pCirBuf->tail < CIRBUF_BUFSIZE);
+    // fill the record and publish it, the first cell at last
+    record_store(pCirBuf, pos, pHdr, pEdges);
 
-    return retCode;
+    for (size_t i = cells; i > 0U; i--)
+    {
+        __atomic_store_n(&pSeq[(pos + i - 1U) & pCirBuf->mask], pos + i, __ATOMIC_RELEASE);
+    }
+
+    return ERROR_OK;
 }
 
+#else /* CIRBUF_LANES */
+
 /**
- * @brief       Is Edge Delimiter
- * @details     This method is used to check if an edge is a delimiter.
- * @param       ed      Edge which should be checked
- * @return      True if the edge is a delimiter, false otherwise
- * @retval      true    The edge is a delimiter
- * @retval      false   The edge is not a delimiter
+ * @brief       Circular Buffer Read (lane)
+ * @details     This method is used to read a whole record from a single-producer/single-consumer lane.
+ *              The writer only moves the head and the reader only moves the tail, so no read-modify-write operation
+ *              is needed. The head of the writer is only loaded again if the cached copy says the lane is empty.
+ *              The method does not block, so the caller has to retry.
+ *              If the edges do not fit into the result array, the record stays in the lane and only its header is
+ *              returned.
+ *
+ * @param       pCirBuf     Pointer to the lane
+ * @param       pSems       Pointer to the semaphores (unused)
+ * @param       pHdr        Pointer where the header of the record gets written to
+ * @param       pEdges      Pointer to the result array
+ * @param       maxEdges    Number of edges the result array can hold
+ *
+ * @return      Error code
+ * @retval      ERROR_OK            Everything went fine
+ * @retval      ERROR_NULLPTR       One of the pointers was NULL
+ * @retval      ERROR_LIMIT         The result array is too small, the header holds the needed size
+ * @retval      ERROR_CIRBUF_EMPTY  There is nothing to read at the moment
 */
-bool is_edge_delimiter(edge_t ed)
+error_t circular_buffer_read(shared_mem_circbuf_t* pCirBuf, sems_t* pSems, record_header_t* pHdr, edge_t* pEdges,
+                             size_t maxEdges)
 {
-    return (ed.start == DELIMITER_VERTEX) && (ed.end == DELIMITER_VERTEX);
+    size_t tail = 0U;
+
+    (void)pSems;
+
+    // check if all pointer are valid
+    if ((NULL == pCirBuf) || (NULL == pHdr) || (NULL == pEdges))
+    {
+        return ERROR_NULLPTR;
+    }
+
+    tail = pCirBuf->tail;
+
+    if (pCirBuf->headCache == tail)
+    {
+        pCirBuf->headCache = __atomic_load_n(&pCirBuf->head, __ATOMIC_ACQUIRE);
+
+        if (pCirBuf->headCache == tail)
+        {
+            return ERROR_CIRBUF_EMPTY;
+        }
+    }
+
+    record_header(pCirBuf, tail, pHdr);
+
+    if (pHdr->edgeCnt > maxEdges)
+    {
+        return ERROR_LIMIT;
+    }
+
+    // copy the solution from the record to the result address
+    record_load(pCirBuf, tail, pEdges, pHdr->edgeCnt);
+
+    // release the cells
+    __atomic_store_n(&pCirBuf->tail, tail + record_cells(pHdr->edgeCnt), __ATOMIC_RELEASE);
+
+    return ERROR_OK;
 }
+
+/**
+ * @brief       Circular Buffer Write (lane)
+ * @details     This method is used to write a whole record to a single-producer/single-consumer lane.
+ *              Only the generator which claimed the lane is allowed to write to it. The tail of the reader is only
+ *              loaded again if the cached copy says the lane is full.
+ *              The method does not block, so the caller has to retry if the lane is full.
+ *
+ * @param       pCirBuf     Pointer to the lane
+ * @param       pSems       Pointer to the semaphores (unused)
+ * @param       pHdr        Pointer to the header of the record (holds the number of edges)
+ * @param       pEdges      Pointer to the edges which should be written
+ *
+ * @return      Error code
+ * @retval      ERROR_OK            Everything went fine
+ * @retval      ERROR_NULLPTR       One of the pointers was NULL
+ * @retval      ERROR_LIMIT         The solution is bigger than the whole lane (CIRBUF_RECORD_MAX)
+ * @retval      ERROR_CIRBUF_FULL   There are not enough free cells at the moment
+*/
+error_t circular_buffer_write(shared_mem_circbuf_t* pCirBuf, sems_t* pSems, const record_header_t* pHdr,
+                              const edge_t* pEdges)
+{
+    size_t cells = 0U;
+    size_t head = 0U;
+
+    (void)pSems;
+
+    // check if all pointer are valid
+    if ((NULL == pCirBuf) || (NULL == pHdr) || ((NULL == pEdges) && (0U != pHdr->edgeCnt)))
+    {
+        return ERROR_NULLPTR;
+    }
+
+    // a solution has to fit into the lane
+    if (CIRBUF_RECORD_MAX(pCirBuf->cellCnt) < pHdr->edgeCnt)
+    {
+        return ERROR_LIMIT;
+    }
+
+    cells = record_cells(pHdr->edgeCnt);
+    head = pCirBuf->head;
+
+    if ((head + cells - pCirBuf->tailCache) > pCirBuf->cellCnt)
+    {
+        pCirBuf->tailCache = __atomic_load_n(&pCirBuf->tail, __ATOMIC_ACQUIRE);
+
+        if ((head + cells - pCirBuf->tailCache) > pCirBuf->cellCnt)
+        {
+            return ERROR_CIRBUF_FULL;
+        }
+    }
+
+    // fill the record and publish it
+    record_store(pCirBuf, head, pHdr, pEdges);
+    __atomic_store_n(&pCirBuf->head, head + cells, __ATOMIC_RELEASE);
+
+    return ERROR_OK;
+}
+
+#endif /* CIRBUF_NONBLOCKING */
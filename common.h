@@ -18,6 +18,8 @@
 #include <errno.h>
 #include <fcntl.h> /* For O_* constants */
 #include <fcntl.h>
+#include <inttypes.h>
+#include <stddef.h>
 #include <semaphore.h>
 #include <stdint.h>
 #include <string.h>
@@ -26,15 +28,61 @@
 #include <unistd.h>
 
 #define SHAREDMEM_FILE "12220853_sharedMem" /*!< Name of the shared memory file */
-#define CIRBUF_BUFSIZE 256U                 /*!< Size of the circular buffer */
-#define DELIMITER_VERTEX 0                  /*!< Vertex for the delimiter, delimiter edge is defined by a loop to this vertex */
+#define SHAREDMEM_HUGE_DIR "/dev/hugepages"  /*!< Mount point of the hugetlbfs for the shared memory file */
+#define SHAREDMEM_HUGE_PAGE (2UL << 20)      /*!< Size of a huge page, the shared memory is rounded up to it */
+
+#define CACHE_LINE_SIZE 64U                                      /*!< Size of a cache line in byte */
+#define CACHE_ALIGNED __attribute__((aligned(CACHE_LINE_SIZE))) /*!< Member starts a new cache line */
+
+/*! Layout check at compile time, the array gets a negative size if the condition is false */
+#define LAYOUT_ASSERT(cond, name) typedef char layout_assert_##name[(cond) ? 1 : -1]
+
+#define GRAPH_SHM_FILE "12220853_graph"     /*!< Name of the shared memory file of the graph (read-only) */
+#ifdef CIRBUF_LANES
+#define CIRBUF_LANE_CNT 32U                 /*!< Number of single-producer lanes (maximum of concurrent generators) */
+#define CIRBUF_RING_CNT CIRBUF_LANE_CNT     /*!< Number of circular buffers in the shared memory */
+#define CIRBUF_DEFAULT_CELLS 64U            /*!< Number of cells in each lane if nothing else is given */
+#else
+#define CIRBUF_RING_CNT 1U                  /*!< Number of circular buffers in the shared memory */
+#define CIRBUF_DEFAULT_CELLS 256U           /*!< Number of cells in the circular buffer if nothing else is given */
+#endif
+#define CIRBUF_MIN_CELLS 16U                /*!< Smallest number of cells of a circular buffer (power of two) */
+#define CIRBUF_MAX_CELLS (1U << 20)         /*!< Biggest number of cells of a circular buffer (power of two) */
+#define CIRBUF_CELL_SIZE CACHE_LINE_SIZE    /*!< Size of a cell in byte (one cache line), records are padded to it */
+
+#define CIRBUF_READ_TIMEOUT_MS 100L         /*!< Maximum time a blocking read waits for a solution */
+
+#if defined(CIRBUF_LOCKFREE) && defined(CIRBUF_LANES)
+#error "CIRBUF_LOCKFREE and CIRBUF_LANES cannot be used together"
+#endif
+
+#if defined(CIRBUF_LOCKFREE) || defined(CIRBUF_LANES)
+#define CIRBUF_NONBLOCKING /*!< The circular buffer does not block, callers have to retry with a backoff */
+#endif
 
 #define SEM_NAME_MUTEX "12220853_sem_mutex"
 #define SEM_NAME_READ "12220853_sem_read"
 #define SEM_NAME_WRITE "12220853_sem_write"
 
-#define BEST_SOL_ARRAY_SIZE 32U /*!< Maximum number of edges for the best solution */
-#define MAX_SOL_SIZE        8U  /*!< Maximum of edges for a accepted solution */
+/*! Maximum of edges of a solution in a buffer with the given number of cells (all cells without the header) */
+#define CIRBUF_RECORD_MAX(cells) ((((cells) * CIRBUF_CELL_SIZE) - sizeof(record_header_t)) / sizeof(edge_t))
+/*! Number of cells of a record with the given number of edges (header and edges, padded to whole cells) */
+#define CIRBUF_RECORD_CELLS(edgeCnt) \
+    ((sizeof(record_header_t) + (sizeof(edge_t) * (edgeCnt)) + CIRBUF_CELL_SIZE - 1U) / CIRBUF_CELL_SIZE)
+#define SHAREDMEM_COMP_CNT 256U /*!< Number of components which get a published bound in the shared memory */
+#define RECORD_OPTIMAL 0x1U      /*!< record flag: the solution is proven to be minimum for its component */
+#define BEST_SOL_ARRAY_SIZE 32U /*!< Initial number of edges of the solution arrays of the supervisor (they grow) */
+
+/* **** VERTICES **** */
+#ifdef VERTEX_32BIT
+typedef uint32_t vertex_t;       /*!< id of a vertex */
+#define VERTEX_MAX UINT32_MAX    /*!< biggest vertex id */
+#define PRIvertex PRIu32         /*!< printf format of a vertex id */
+#else
+typedef uint16_t vertex_t;       /*!< id of a vertex */
+#define VERTEX_MAX UINT16_MAX    /*!< biggest vertex id */
+#define PRIvertex PRIu16         /*!< printf format of a vertex id */
+#endif
 
 /*!
  * @struct edge_t
@@ -42,8 +90,8 @@
  **/
 typedef struct
 {
-    uint16_t start; /*!< start vertex */
-    uint16_t end;   /*!< end vertex */
+    vertex_t start; /*!< start vertex */
+    vertex_t end;   /*!< end vertex */
 
 } edge_t;
 
@@ -51,30 +99,110 @@ typedef struct
  * @struct shared_mem_flags_t
  * @brief   Bundle for all runtime and configuration flags
  *
- * @details
+ * @details The control fields are written by the supervisor (rarely) and read by the generators in every round,
+ *          the counters are written by the generators. Both groups have their own cache line, so counting a
+ *          solution does not invalidate the line every generator polls.
  *
  **/
 typedef struct
 {
-    bool genActive;  /*!< Flag that the generators should be active */
-    ssize_t numSols; /*!< Number of solutions found */
+    /* control, written by the supervisor */
+    bool genActive CACHE_ALIGNED; /*!< Flag that the generators should be active */
+    size_t maxSolSize;            /*!< Biggest solution the supervisor accepts, set before the generators get active */
+    uint64_t seed;                /*!< Common seed for the random number generators of all generators */
+    size_t epoch;                 /*!< Increased (atomic) when the generators should continue with a new seed */
+
+    /* counters, written by the generators */
+    ssize_t numSols CACHE_ALIGNED; /*!< Number of solutions found (sent or discarded because of compBest, atomic) */
+    size_t genCnt;                 /*!< Number of generators which were started (atomic), used as id of a generator */
 } shared_mem_flags_t;
 
+/*!
+ * @struct record_header_t
+ * @brief  Header of a solution record in the circular buffer
+ *
+ * @details A record is the header followed by the packed edges of the solution. It starts at the beginning of a cell
+ *          and is padded to whole cells, only the edges may wrap around at the end of the buffer.
+ *          The solution only covers one cyclic component of the graph, the supervisor combines the best solutions of
+ *          all components. A graph without cyclic components is reported with compCnt 0 and no edges.
+ *          Solutions of the exact solver carry RECORD_OPTIMAL, nothing smaller exists for their component.
+ **/
 typedef struct
 {
-    ssize_t head;               /*!< Index to the head (write end) */
-    ssize_t tail;               /*!< Index to the tail (read end) */
-    edge_t buf[CIRBUF_BUFSIZE]; /*!< actual memory of the circular buffer */
+    uint32_t genId;   /*!< id of the generator which found the solution */
+    uint32_t edgeCnt; /*!< number of edges following the header */
+    uint64_t seq;     /*!< number of the solution, counted by each generator */
+    uint32_t comp;    /*!< cyclic component the solution belongs to */
+    uint32_t compCnt; /*!< number of cyclic components of the graph */
+    uint32_t flags;   /*!< RECORD_OPTIMAL or 0 */
+} record_header_t;
+
+/*!
+ * @struct shared_mem_circbuf_t
+ * @brief  Circular buffer of solution records
+ *
+ * @details With the semaphore version head and tail are cell indexes into the buffer. If the application is built
+ *          with CIRBUF_LOCKFREE or CIRBUF_LANES they are ever increasing positions, the index is the position modulo
+ *          the number of cells.
+ *          The number of cells is chosen by the supervisor at runtime, so the sequence numbers (cellCnt elements,
+ *          padded to a cache line) and the cells follow directly after this struct.
+ *          The layout, the fields of the producers and of the consumer start on their own cache lines. In a lane
+ *          each side keeps a copy of the index of the other side and only reloads it when the lane looks full (empty).
+ **/
+typedef struct
+{
+    /* layout, read-only after the init */
+    size_t cellCnt CACHE_ALIGNED; /*!< Number of cells (power of two) */
+    size_t mask;                  /*!< cellCnt - 1, to get the index of a position */
+
+    /* producer */
+    size_t head CACHE_ALIGNED; /*!< Index to the head (write end) */
+    size_t tailCache;          /*!< Last tail seen by the producer, only used with CIRBUF_LANES */
+    bool claimed;              /*!< Lane is owned by a generator, only used with CIRBUF_LANES */
+
+    /* consumer */
+    size_t tail CACHE_ALIGNED; /*!< Index to the tail (read end) */
+    size_t headCache;          /*!< Last head seen by the consumer, only used with CIRBUF_LANES */
 } shared_mem_circbuf_t;
 
+/*!
+ * @struct shared_mem_t
+ * @brief  Header of the shared memory
+ *
+ * @details The header is followed by CIRBUF_RING_CNT circular buffers of ringSize byte each (one per lane with
+ *          CIRBUF_LANES). The size is written by the supervisor before the generators get active, so they can map
+ *          the whole memory.
+ *          The supervisor publishes the size of the best solution of every component, generators only send smaller
+ *          ones. It marks components with a proven minimum solution as solved, generators leave them then.
+ *          Only one generator at a time runs an exact solver on a component, it claims the component with its process
+ *          id first. The claims of a generator which ended are released by the supervisor when it reaps the process,
+ *          a generator takes over a claim whose process does not exist anymore (a generator started by hand).
+ *          Components from SHAREDMEM_COMP_CNT on have no published bound and are never marked.
+ **/
 typedef struct
 {
     shared_mem_flags_t flags; /*!< All flags needed for the shared memory */
 
-    shared_mem_circbuf_t circbuf; /*!< Bundle for the circular buffer */
+    size_t size CACHE_ALIGNED; /*!< Size of the whole shared memory in byte (header and all circular buffers) */
+    size_t cellCnt;            /*!< Number of cells of every circular buffer */
+    size_t ringSize;           /*!< Size of one circular buffer with its sequence numbers and cells in byte */
 
+    size_t compBest[SHAREDMEM_COMP_CNT] CACHE_ALIGNED; /*!< best solution of every component (atomic), or SIZE_MAX */
+    bool compSolved[SHAREDMEM_COMP_CNT];               /*!< minimum of the component is known (atomic) */
+    pid_t compClaimed[SHAREDMEM_COMP_CNT];             /*!< process which runs an exact solver on it, 0 if none (atomic) */
 } shared_mem_t;
 
+/* **** LAYOUT **** */
+LAYOUT_ASSERT(0U == (offsetof(shared_mem_flags_t, numSols) % CACHE_LINE_SIZE), counters_own_line);
+LAYOUT_ASSERT(0U == (offsetof(shared_mem_circbuf_t, tail) % CACHE_LINE_SIZE), consumer_own_line);
+LAYOUT_ASSERT(offsetof(shared_mem_circbuf_t, tail) >= (offsetof(shared_mem_circbuf_t, head) + CACHE_LINE_SIZE),
+              producer_own_line);
+LAYOUT_ASSERT(0U == (offsetof(shared_mem_circbuf_t, head) % CACHE_LINE_SIZE), producer_aligned);
+LAYOUT_ASSERT(0U == (sizeof(shared_mem_circbuf_t) % CACHE_LINE_SIZE), circbuf_padded);
+LAYOUT_ASSERT(0U == (offsetof(shared_mem_t, flags) % CACHE_LINE_SIZE), flags_aligned);
+LAYOUT_ASSERT(0U == (sizeof(shared_mem_t) % CACHE_LINE_SIZE), header_padded);
+LAYOUT_ASSERT(sizeof(record_header_t) <= CIRBUF_CELL_SIZE, header_fits_cell);
+
 /*!
  * @struct sems_t
  * @brief  Structure of needed semaphores
@@ -91,6 +219,14 @@ typedef struct
 
 /* **** FUNCTIONS **** */
 void emit_error(char* msg, error_t retCode);
-error_t circular_buffer_read(shared_mem_circbuf_t* pCirBuf, sems_t* pSems, edge_t* pResult);
-error_t circular_buffer_write(shared_mem_circbuf_t* pCirBuf, sems_t* pSems, edge_t* pEd);
-bool is_edge_delimiter(edge_t ed);
+size_t shared_mem_size(size_t cellCnt);
+error_t shared_mem_init(shared_mem_t* pSharedMem, size_t cellCnt, size_t size);
+shared_mem_circbuf_t* shared_mem_ring(shared_mem_t* pSharedMem, size_t ring);
+error_t circular_buffer_init(shared_mem_circbuf_t* pCirBuf, size_t cellCnt);
+error_t circular_buffer_attach(shared_mem_t* pSharedMem, shared_mem_circbuf_t** ppCirBuf);
+void circular_buffer_detach(shared_mem_circbuf_t* pCirBuf);
+void circular_buffer_backoff(size_t* pRound);
+error_t circular_buffer_read(shared_mem_circbuf_t* pCirBuf, sems_t* pSems, record_header_t* pHdr, edge_t* pEdges,
+                             size_t maxEdges);
+error_t circular_buffer_write(shared_mem_circbuf_t* pCirBuf, sems_t* pSems, const record_header_t* pHdr,
+                              const edge_t* pEdges);
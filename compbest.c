@@ -0,0 +1,238 @@
+#include "compbest.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file compbest.c
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ */
+
+/**
+ * @brief       Comp Best Alloc
+ * @details     This internal method is used to allocate the tables for the given number of components.
+ *
+ * @param       pBest       Pointer to the best solutions
+ * @param       compCnt     Number of cyclic components
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ */
+static error_t compbest_alloc(compbest_t* pBest, size_t compCnt)
+{
+    pBest->ppSols = calloc(sizeof(edge_t*), compCnt);
+    pBest->pSizes = malloc(sizeof(size_t) * compCnt);
+    pBest->pCaps = calloc(sizeof(size_t), compCnt);
+    pBest->pOptimal = calloc(sizeof(bool), compCnt);
+
+    if ((NULL == pBest->ppSols) || (NULL == pBest->pSizes) || (NULL == pBest->pCaps) || (NULL == pBest->pOptimal))
+    {
+        compbest_free(pBest);
+        return ERROR_NULLPTR;
+    }
+
+    for (size_t i = 0U; i < compCnt; i++)
+    {
+        pBest->pSizes[i] = SIZE_MAX;
+    }
+
+    pBest->compCnt = compCnt;
+
+    return ERROR_OK;
+}
+
+/**
+ * @brief       Comp Best Update
+ * @details     This method is used to take a solution of one component. It is kept if it is smaller than the best
+ *              solution of this component so far. A solution with RECORD_OPTIMAL marks the component as proven, even
+ *              if a solution of the same size was known already.
+ *
+ * @param       pBest       Pointer to the best solutions
+ * @param       pHdr        Pointer to the header of the record (component and number of components)
+ * @param       pEdges      Pointer to the edges of the solution
+ * @param       pImproved   Pointer where true gets written to if the solution is the new best of its component
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ * @retval      ERROR_PARAM     The record does not match the components (generator with another graph)
+ */
+error_t compbest_update(compbest_t* pBest, const record_header_t* pHdr, const edge_t* pEdges, bool* pImproved)
+{
+    size_t comp = pHdr->comp;
+
+    *pImproved = false;
+
+    if ((0U == pBest->compCnt) && (0U != pHdr->compCnt))
+    {
+        if (ERROR_OK != compbest_alloc(pBest, pHdr->compCnt))
+        {
+            return ERROR_NULLPTR;
+        }
+    }
+
+    if ((pHdr->compCnt != pBest->compCnt) || (comp >= pBest->compCnt))
+    {
+        return ERROR_PARAM;
+    }
+
+    if ((0U != (pHdr->flags & RECORD_OPTIMAL)) && !pBest->pOptimal[comp])
+    {
+        pBest->pOptimal[comp] = true;
+        pBest->proven++;
+    }
+
+    if (pHdr->edgeCnt >= pBest->pSizes[comp])
+    {
+        return ERROR_OK;
+    }
+
+    if (pHdr->edgeCnt > pBest->pCaps[comp])
+    {
+        edge_t* pGrown = realloc(pBest->ppSols[comp], sizeof(edge_t) * pHdr->edgeCnt);
+
+        if (NULL == pGrown)
+        {
+            return ERROR_NULLPTR;
+        }
+
+        pBest->ppSols[comp] = pGrown;
+        pBest->pCaps[comp] = pHdr->edgeCnt;
+    }
+
+    memcpy(pBest->ppSols[comp], pEdges, sizeof(edge_t) * pHdr->edgeCnt);
+
+    if (SIZE_MAX == pBest->pSizes[comp])
+    {
+        pBest->known++;
+    }
+    else
+    {
+        pBest->total -= pBest->pSizes[comp];
+    }
+
+    pBest->pSizes[comp] = pHdr->edgeCnt;
+    pBest->total += pHdr->edgeCnt;
+    *pImproved = true;
+
+    return ERROR_OK;
+}
+
+/**
+ * @brief       Comp Best Complete
+ * @details     This method is used to check if every component has a solution, so there is one for the whole graph.
+ *
+ * @param       pBest       Pointer to the best solutions
+ *
+ * @return      true if every component has a solution
+ */
+bool compbest_complete(const compbest_t* pBest)
+{
+    return (0U != pBest->compCnt) && (pBest->known == pBest->compCnt);
+}
+
+/**
+ * @brief       Comp Best Proven
+ * @details     This method is used to check if the minimum of every component is known, so the solution of the whole
+ *              graph is a minimum one and the search can stop.
+ *
+ * @param       pBest       Pointer to the best solutions
+ *
+ * @return      true if every component has a proven minimum solution
+ */
+bool compbest_proven(const compbest_t* pBest)
+{
+    return compbest_complete(pBest) && (pBest->proven == pBest->compCnt);
+}
+
+/**
+ * @brief       Comp Best Bound
+ * @details     This method is used to take a lower bound of a component. If the best solution of the component is not
+ *              bigger than the bound, it is a minimum one and the component is proven.
+ *
+ * @param       pBest       Pointer to the best solutions
+ * @param       comp        Number of the component
+ * @param       lower       Lower bound of the minimum solution of the component
+ *
+ * @return      true if the component got proven by the bound
+ */
+bool compbest_bound(compbest_t* pBest, size_t comp, size_t lower)
+{
+    if ((comp >= pBest->compCnt) || pBest->pOptimal[comp] || (SIZE_MAX == pBest->pSizes[comp]) ||
+        (lower < pBest->pSizes[comp]))
+    {
+        return false;
+    }
+
+    pBest->pOptimal[comp] = true;
+    pBest->proven++;
+
+    return true;
+}
+
+/**
+ * @brief       Comp Best Combine
+ * @details     This method is used to build the solution of the whole graph from the best solutions of all
+ *              components. The components have no edge in common, so the union is just the concatenation.
+ *
+ * @param       pBest       Pointer to the best solutions (complete)
+ * @param       ppSol       Pointer to the array of the solution (may be reallocated)
+ * @param       pCapacity   Pointer to the number of edges the array can hold (may be increased)
+ * @param       pEdgeCnt    Pointer where the number of edges gets written to
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_NULLPTR   The array could not be grown
+ */
+error_t compbest_combine(const compbest_t* pBest, edge_t** ppSol, size_t* pCapacity, size_t* pEdgeCnt)
+{
+    size_t fill = 0U;
+
+    if (pBest->total > *pCapacity)
+    {
+        edge_t* pGrown = realloc(*ppSol, sizeof(edge_t) * pBest->total);
+
+        if (NULL == pGrown)
+        {
+            return ERROR_NULLPTR;
+        }
+
+        *ppSol = pGrown;
+        *pCapacity = pBest->total;
+    }
+
+    for (size_t i = 0U; i < pBest->compCnt; i++)
+    {
+        memcpy(*ppSol + fill, pBest->ppSols[i], sizeof(edge_t) * pBest->pSizes[i]);
+        fill += pBest->pSizes[i];
+    }
+
+    *pEdgeCnt = fill;
+
+    return ERROR_OK;
+}
+
+/**
+ * @brief       Comp Best Free
+ * @details     This method is used to free all solutions and tables.
+ *
+ * @param       pBest       Pointer to the best solutions
+ */
+void compbest_free(compbest_t* pBest)
+{
+    if (NULL != pBest->ppSols)
+    {
+        for (size_t i = 0U; i < pBest->compCnt; i++)
+        {
+            free(pBest->ppSols[i]);
+        }
+    }
+
+    free(pBest->ppSols);
+    free(pBest->pSizes);
+    free(pBest->pCaps);
+    free(pBest->pOptimal);
+    memset(pBest, 0, sizeof(compbest_t));
+}
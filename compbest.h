@@ -0,0 +1,44 @@
+#pragma once
+
+/**
+ * @file  compbest.h
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ * @brief Best solutions of the cyclic components, combined to a solution of the whole graph (supervisor)
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common.h"
+#include "errors.h"
+
+/*!
+ * @struct compbest_t
+ * @brief  Best known solution of every cyclic component
+ *
+ * @details The number of components is taken from the first record, all generators decompose the same graph.
+ *          A solution of the whole graph is known as soon as every component has one, it is the union of them.
+ *          If the solutions of all components are proven minimum (RECORD_OPTIMAL, or they meet a lower bound), so is
+ *          their union.
+ **/
+typedef struct
+{
+    size_t compCnt;  /*!< number of cyclic components, 0 until the first record arrived */
+    edge_t** ppSols; /*!< best solution of every component */
+    size_t* pSizes;  /*!< number of edges of the best solution of every component, SIZE_MAX if there is none */
+    size_t* pCaps;   /*!< number of edges every solution array can hold */
+    bool* pOptimal;  /*!< the best solution of the component is proven minimum */
+    size_t known;    /*!< number of components which have a solution */
+    size_t total;    /*!< sum of the sizes of the known solutions */
+    size_t proven;   /*!< number of components with a proven minimum */
+} compbest_t;
+
+/* **** FUNCTIONS **** */
+error_t compbest_update(compbest_t* pBest, const record_header_t* pHdr, const edge_t* pEdges, bool* pImproved);
+bool compbest_complete(const compbest_t* pBest);
+bool compbest_proven(const compbest_t* pBest);
+bool compbest_bound(compbest_t* pBest, size_t comp, size_t lower);
+error_t compbest_combine(const compbest_t* pBest, edge_t** ppSol, size_t* pCapacity, size_t* pEdgeCnt);
+void compbest_free(compbest_t* pBest);
@@ -0,0 +1,332 @@
+#include "edgeparse.h"
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @file edgeparse.c
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ */
+
+/**
+ * @brief       Is Space
+ * @details     This internal method is used to check if a character separates two edges.
+ *
+ * @param       c       Character
+ *
+ * @return      true if the character is a separator
+ */
+static bool is_space(char c) { return (' ' == c) || ('\n' == c) || ('\t' == c) || ('\r' == c); }
+
+/**
+ * @brief       Next Token
+ * @details     This internal method is used to find the next edge in a buffer, nothing gets copied or allocated.
+ *              Everything from a '#' to the end of the line is a comment.
+ *
+ * @param       pBuf        Pointer to the buffer
+ * @param       len         Length of the buffer
+ * @param       pOff        Pointer to the current offset (read and write), points behind the token afterwards
+ * @param       pTokLen     Pointer where the length of the token gets written to
+ *
+ * @return      Pointer to the token, NULL if there is none left
+ */
+static const char* next_token(const char* pBuf, size_t len, size_t* pOff, size_t* pTokLen)
+{
+    size_t off = *pOff;
+    size_t start = 0U;
+
+    while (off < len)
+    {
+        if ('#' == pBuf[off])
+        {
+            while ((off < len) && ('\n' != pBuf[off]))
+            {
+                off++;
+            }
+        }
+        else if (is_space(pBuf[off]))
+        {
+            off++;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if (off >= len)
+    {
+        *pOff = len;
+        return NULL;
+    }
+
+    start = off;
+    while ((off < len) && !is_space(pBuf[off]) && ('#' != pBuf[off]))
+    {
+        off++;
+    }
+
+    *pOff = off;
+    *pTokLen = off - start;
+
+    return &pBuf[start];
+}
+
+/**
+ * @brief       Parse Vertex
+ * @details     This internal method is used to parse a vertex id (decimal, at most VERTEX_MAX).
+ *
+ * @param       pStr        Pointer to the first digit
+ * @param       pEnd        Pointer behind the last character which may be used
+ * @param       pVertex     Pointer where the vertex gets written to
+ *
+ * @return      Pointer behind the last digit, NULL if there is no valid number
+ */
+static const char* parse_vertex(const char* pStr, const char* pEnd, vertex_t* pVertex)
+{
+    uint64_t value = 0U;
+    const char* pCurr = pStr;
+
+    while ((pCurr < pEnd) && ('0' <= *pCurr) && ('9' >= *pCurr))
+    {
+        value = (value * 10U) + (uint64_t)(*pCurr - '0');
+
+        if (VERTEX_MAX < value)
+        {
+            return NULL;
+        }
+        pCurr++;
+    }
+
+    if (pCurr == pStr)
+    {
+        return NULL;
+    }
+
+    *pVertex = (vertex_t)value;
+
+    return pCurr;
+}
+
+/**
+ * @brief       Edgeparse Token
+ * @details     This method is used to parse a single edge in the form "start-end".
+ *              The token does not have to be null-terminated.
+ *
+ * @param       pStr        Pointer to the token
+ * @param       len         Length of the token
+ * @param       pEdge       Pointer where the edge gets written to
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_PARAM     The token is not a valid edge
+ */
+error_t edgeparse_token(const char* pStr, size_t len, edge_t* pEdge)
+{
+    const char* pEnd = pStr + len;
+    const char* pCurr = parse_vertex(pStr, pEnd, &pEdge->start);
+
+    if ((NULL == pCurr) || (pCurr >= pEnd) || ('-' != *pCurr))
+    {
+        return ERROR_PARAM;
+    }
+
+    pCurr = parse_vertex(pCurr + 1, pEnd, &pEdge->end);
+
+    return ((NULL == pCurr) || (pCurr != pEnd)) ? ERROR_PARAM : ERROR_OK;
+}
+
+/**
+ * @brief       Edgeparse Buffer
+ * @details     This method is used to parse all edges of a buffer, they are separated by whitespaces.
+ *              The edges get counted first, so the array of edges is allocated only once with the exact size.
+ *
+ * @param       pBuf        Pointer to the buffer
+ * @param       len         Length of the buffer
+ * @param       ppEdges     Pointer where the (allocated) array of edges gets written to
+ * @param       pEdgeCnt    Pointer where the number of edges gets written to
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_PARAM     There is an invalid edge or no edge at all
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ */
+error_t edgeparse_buffer(const char* pBuf, size_t len, edge_t** ppEdges, size_t* pEdgeCnt)
+{
+    size_t off = 0U;
+    size_t tokLen = 0U;
+    size_t edgeCnt = 0U;
+    const char* pTok = NULL;
+
+    while (NULL != next_token(pBuf, len, &off, &tokLen))
+    {
+        edgeCnt++;
+    }
+
+    if (0U == edgeCnt)
+    {
+        return ERROR_PARAM;
+    }
+
+    *ppEdges = malloc(sizeof(edge_t) * edgeCnt);
+
+    if (NULL == *ppEdges)
+    {
+        return ERROR_NULLPTR;
+    }
+
+    off = 0U;
+    for (size_t i = 0U; i < edgeCnt; i++)
+    {
+        pTok = next_token(pBuf, len, &off, &tokLen);
+
+        if (ERROR_OK != edgeparse_token(pTok, tokLen, &(*ppEdges)[i]))
+        {
+            free(*ppEdges);
+            *ppEdges = NULL;
+            return ERROR_PARAM;
+        }
+    }
+
+    *pEdgeCnt = edgeCnt;
+
+    return ERROR_OK;
+}
+
+/**
+ * @brief       Read All
+ * @details     This internal method is used to read everything from a file descriptor which cannot be mapped
+ *              (stdin, pipes).
+ *
+ * @param       fd          File descriptor
+ * @param       ppBuf       Pointer where the (allocated) buffer gets written to
+ * @param       pLen        Pointer where the number of read bytes gets written to
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_FILE      Reading failed
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ */
+static error_t read_all(int fd, char** ppBuf, size_t* pLen)
+{
+    size_t cap = EDGEPARSE_READ_CHUNK;
+    size_t len = 0U;
+    char* pBuf = malloc(cap);
+    ssize_t ret = 0;
+
+    while (NULL != pBuf)
+    {
+        if (len == cap)
+        {
+            char* pNew = realloc(pBuf, cap * 2U);
+
+            if (NULL == pNew)
+            {
+                break;
+            }
+            pBuf = pNew;
+            cap *= 2U;
+        }
+
+        ret = read(fd, pBuf + len, cap - len);
+
+        if (ret <= 0)
+        {
+            break;
+        }
+        len += (size_t)ret;
+    }
+
+    if ((NULL == pBuf) || (len == cap))
+    {
+        free(pBuf);
+        return ERROR_NULLPTR;
+    }
+
+    if (ret < 0)
+    {
+        free(pBuf);
+        return ERROR_FILE;
+    }
+
+    *ppBuf = pBuf;
+    *pLen = len;
+
+    return ERROR_OK;
+}
+
+/**
+ * @brief       Edgeparse File
+ * @details     This method is used to read all edges from a file, EDGEPARSE_STDIN reads from stdin.
+ *              Regular files are mapped into memory and parsed in place, everything else is read into a buffer first.
+ *
+ * @param       pPath       Path to the file
+ * @param       ppEdges     Pointer where the (allocated) array of edges gets written to
+ * @param       pEdgeCnt    Pointer where the number of edges gets written to
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_FILE      The file could not be opened or read
+ * @retval      ERROR_PARAM     There is an invalid edge or no edge at all
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ */
+error_t edgeparse_file(const char* pPath, edge_t** ppEdges, size_t* pEdgeCnt)
+{
+    error_t retCode = ERROR_OK;
+    struct stat st = {0};
+    char* pBuf = NULL;
+    size_t len = 0U;
+    int fd = STDIN_FILENO;
+
+    if (0 != strcmp(pPath, EDGEPARSE_STDIN))
+    {
+        fd = open(pPath, O_RDONLY);
+
+        if (fd < 0)
+        {
+            return ERROR_FILE;
+        }
+    }
+
+    if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (0 < st.st_size))
+    {
+        len = (size_t)st.st_size;
+        pBuf = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (MAP_FAILED == pBuf)
+        {
+            retCode = ERROR_FILE;
+        }
+        else
+        {
+            // the file is read once from the front to the back
+            madvise(pBuf, len, MADV_SEQUENTIAL);
+            retCode = edgeparse_buffer(pBuf, len, ppEdges, pEdgeCnt);
+            munmap(pBuf, len);
+        }
+    }
+    else
+    {
+        retCode = read_all(fd, &pBuf, &len);
+
+        if (ERROR_OK == retCode)
+        {
+            retCode = edgeparse_buffer(pBuf, len, ppEdges, pEdgeCnt);
+            free(pBuf);
+        }
+    }
+
+    if (STDIN_FILENO != fd)
+    {
+        close(fd);
+    }
+
+    return retCode;
+}
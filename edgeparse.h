@@ -0,0 +1,21 @@
+#pragma once
+
+/**
+ * @file  edgeparse.h
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ * @brief Parser for the edges of the graph (parameters, files and stdin)
+ */
+
+#include <stddef.h>
+
+#include "common.h"
+#include "errors.h"
+
+#define EDGEPARSE_STDIN "-"          /*!< file name which stands for stdin */
+#define EDGEPARSE_READ_CHUNK 65536U /*!< number of bytes read at once if the input cannot be mapped */
+
+/* **** FUNCTIONS **** */
+error_t edgeparse_token(const char* pStr, size_t len, edge_t* pEdge);
+error_t edgeparse_buffer(const char* pBuf, size_t len, edge_t** ppEdges, size_t* pEdgeCnt);
+error_t edgeparse_file(const char* pPath, edge_t** ppEdges, size_t* pEdgeCnt);
@@ -21,4 +21,5 @@ typedef uint16_t error_t;
 #define ERROR_NULLPTR 0x40U         /*<! @brief Nullpointer Error */
 #define ERROR_SHMEM 0x80U           /*<! @brief Shared Memory Error */
 #define ERROR_SIGINT 0x100U         /*<! @brief Signal Happend */
-#define ERROR_LIMIT 0x200U          /*<! @brief Limit was reached */
\ No newline at end of file
+#define ERROR_LIMIT 0x200U          /*<! @brief Limit was reached */
+#define ERROR_FILE 0x400U           /*<! @brief File Error */
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "exact.h"
+
+#include <stdlib.h>
+
+/**
+ * @file exact.c
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ */
+
+/**
+ * @brief       Exact Order
+ * @details     This method is used to find a vertex order with the fewest back edges, so its back edges are a minimum
+ *              feedback arc set.
+ *              cost[S] is the fewest back edges among the vertices of the subset S if they are placed first. The last
+ *              of them, v, adds the edges from v to the rest of S, which is a popcount of its successor mask:
+ *              cost[S] = min over v in S of cost[S \ {v}] + popcount(out[v] & S).
+ *              This takes O(2^n * n) time and 2^n costs of memory. The order is rebuilt backwards from the whole set
+ *              by looking for a vertex which gives the cost, so no choice has to be stored.
+ *
+ * @param       pSoa        Pointer to the edges (local ids, no loops)
+ * @param       vertCnt     Number of vertices, at most EXACT_MAX_VERT
+ * @param       pVert       Pointer to the order of the vertices (write, vertCnt elements)
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_PARAM     Too many vertices (or too many edges for the costs)
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ */
+error_t exact_order(const edge_soa_t* pSoa, size_t vertCnt, vertex_t* pVert)
+{
+    uint32_t out[EXACT_MAX_VERT] = {0U};
+    uint32_t full = 0U;
+    uint16_t* pCost = NULL;
+
+    if ((EXACT_MAX_VERT < vertCnt) || (UINT16_MAX < pSoa->edgeCnt))
+    {
+        return ERROR_PARAM;
+    }
+
+    full = (uint32_t)((1U << vertCnt) - 1U);
+    pCost = malloc(sizeof(uint16_t) * ((size_t)full + 1U));
+
+    if (NULL == pCost)
+    {
+        return ERROR_NULLPTR;
+    }
+
+    for (size_t i = 0U; i < pSoa->edgeCnt; i++)
+    {
+        out[pSoa->pStart[i]] |= 1U << pSoa->pEnd[i];
+    }
+
+    pCost[0] = 0U;
+
+    for (uint32_t set = 1U; set <= full; set++)
+    {
+        uint32_t best = UINT32_MAX;
+
+        for (uint32_t rest = set; 0U != rest; rest &= rest - 1U)
+        {
+            uint32_t v = (uint32_t)__builtin_ctz(rest);
+            uint32_t cost = pCost[set & ~(1U << v)] + (uint32_t)__builtin_popcount(out[v] & set);
+
+            if (cost < best)
+            {
+                best = cost;
+            }
+        }
+
+        pCost[set] = (uint16_t)best;
+    }
+
+    // the last vertex of the order is one which gives the cost of the whole set, and so on
+    for (uint32_t set = full, pos = (uint32_t)vertCnt; 0U != set; )
+    {
+        for (uint32_t rest = set; 0U != rest; rest &= rest - 1U)
+        {
+            uint32_t v = (uint32_t)__builtin_ctz(rest);
+            uint32_t prev = set & ~(1U << v);
+
+            if ((pCost[prev] + (uint32_t)__builtin_popcount(out[v] & set)) == pCost[set])
+            {
+                pos--;
+                pVert[pos] = (vertex_t)v;
+                set = prev;
+                break;
+            }
+        }
+    }
+
+    free(pCost);
+
+    return ERROR_OK;
+}
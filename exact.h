@@ -0,0 +1,20 @@
+#pragma once
+
+/**
+ * @file  exact.h
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ * @brief Exact minimum feedback arc set of small graphs (dynamic program over the vertex subsets)
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "backedges.h"
+#include "common.h"
+#include "errors.h"
+
+#define EXACT_MAX_VERT 24U /*!< Biggest number of vertices which gets solved exactly (2^n costs of 2 byte) */
+
+/* **** FUNCTIONS **** */
+error_t exact_order(const edge_soa_t* pSoa, size_t vertCnt, vertex_t* pVert);
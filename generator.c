@@ -4,14 +4,32 @@
  * @date 2023-11-07
  */
 
+#include <getopt.h>
 #include <inttypes.h>
 #include <semaphore.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "backedges.h"
 #include "common.h"
 #include "debug.h"
+#include "edgeparse.h"
 #include "errors.h"
+#include "graph.h"
+#include "search.h"
+
+/**
+ * @brief Bundle of options
+ * @details This bundle is used to bundle all option of this module for easier access.
+ */
+typedef struct
+{
+    bool localSearch;  /*!< improve every random order with the local search before it gets evaluated */
+    bool greedy;       /*!< build the orders with the greedy heuristic instead of shuffling */
+    const char* pFile; /*!< file with the edges ("-" for stdin), NULL if they are given as parameters */
+    size_t bnbThreads; /*!< threads of the branch and bound on medium components, 0 if it is not used */
+} options_t;
 
 static const char* gAppName; /*!< Name of the application */
 
@@ -23,10 +41,91 @@ static const char* gAppName; /*!< Name of the application */
 static void usage(char* msg)
 {
     // print the usage message
-    fprintf(stderr, "%s\nUsage: %s [-n limit] [-w delay]\n", msg, gAppName);
+    fprintf(stderr, "%s\nUsage: %s [-l] [-e] [-x threads] [-f file | EDGE1...]\n", msg, gAppName);
     emit_error(msg, ERROR_PARAM);
 }
 
+/**
+ * @brief   Handle Options
+ *
+ * @details This internal method is used to read the option given by the user.
+ *          After this optind points to the first edge. With -f no edges may follow.
+ *
+ * @param   argc    Argument Counter
+ * @param   argv    Argument Variables
+ * @param   pOpts   Pointer to the option bundle
+ **/
+static void handle_opts(int argc, char* argv[], options_t* pOpts)
+{
+    int16_t ret = 0;
+
+    while ((ret = getopt(argc, argv, "lef:x:")) != -1)
+    {
+        switch (ret)
+        {
+            // Local search
+            case 'l': {
+                if (false != pOpts->localSearch)
+                {
+                    /* option was given two times */
+                    usage("Option was given more than once\n");
+                }
+                pOpts->localSearch = true;
+                break;
+            }
+
+            // Greedy order (Eades, Lin, Smyth)
+            case 'e': {
+                if (false != pOpts->greedy)
+                {
+                    /* option was given two times */
+                    usage("Option was given more than once\n");
+                }
+                pOpts->greedy = true;
+                break;
+            }
+
+            // Threads of the branch and bound
+            case 'x': {
+                if (0U != pOpts->bnbThreads)
+                {
+                    /* option was given two times */
+                    usage("Option was given more than once\n");
+                }
+                pOpts->bnbThreads = (size_t)strtol(optarg, NULL, 0);
+
+                if (0U == pOpts->bnbThreads)
+                {
+                    usage("The branch and bound needs at least one thread\n");
+                }
+                break;
+            }
+
+            // File with the edges
+            case 'f': {
+                if (NULL != pOpts->pFile)
+                {
+                    /* option was given two times */
+                    usage("Option was given more than once\n");
+                }
+                pOpts->pFile = optarg;
+                break;
+            }
+
+            // Unknown option
+            default: {
+                usage("Unknown option\n");
+                break;
+            }
+        }
+    }
+
+    if ((NULL != pOpts->pFile) && (optind < argc))
+    {
+        usage("Edges cannot be given as parameters and as file\n");
+    }
+}
+
 /**
  * @brief   Read Edges
  * @details This internal method is used to read the edges from the argv array.
@@ -48,13 +147,26 @@ static void readEdges(edge_t* pEdges[], char** argv, size_t argc)
     for (size_t i = 1U; i < argc; i++)
     {
         // the vertices are separated with a dash, and the edges with a space
-        if (sscanf(argv[i], "%hu-%hu", &((*pEdges)[i - 1].start), &((*pEdges)[i - 1].end)) < 0)
+        if (ERROR_OK != edgeparse_token(argv[i], strlen(argv[i]), &((*pEdges)[i - 1])))
         {
             usage("Something went wrong with reading edges\n");
         }
+    }
+}
 
+/**
+ * @brief   Check Edges
+ * @details This internal method is used to check the edges, no matter where they were read from.
+ *
+ * @param   pEdges      Pointer to the array of edges
+ * @param   edgeCnt     Number of edges
+ */
+static void check_edges(const edge_t* pEdges, size_t edgeCnt)
+{
+    for (size_t i = 0U; i < edgeCnt; i++)
+    {
         // check for loop
-        if ((*pEdges)[i - 1].start == (*pEdges)[i - 1].end)
+        if (pEdges[i].start == pEdges[i].end)
         {
             emit_error("Loops are not allowed\n", ERROR_PARAM);
         }
@@ -132,23 +244,32 @@ static error_t cleanup_semaphores(sems_t* pSems)
  * @details This internal method is used to initialize the shared memory.
  *          It is called when the application is starting.
  *          Firstly the shared memory is opened, then it is mapped.
+ *          If there is no POSIX shared memory, the supervisor put it on huge pages, so the file in the hugetlbfs is
+ *          used. The size of the circular buffers is chosen by the supervisor, so the whole file gets mapped.
  *          The pointer to the struct of shared memory is stored in the pSharedMem pointer.
  *          The file descriptor is stored in the pFd pointer.
  *
  * @param   pSharedMem  Pointer to the struct of shared memory
  * @param   pFd         Pointer to the file descriptor of the shared memory
+ * @param   pSize       Pointer where the size of the mapping gets written to
  *
  * @returns retCode     Error code
  * @retval  ERROR_OK            Everything went fine
  * @retval  ERROR_SHMEM         Something went wrong with opening the shared memory
  */
-static error_t init_shmem(shared_mem_t** pSharedMem, int16_t* pFd)
+static error_t init_shmem(shared_mem_t** pSharedMem, int16_t* pFd, size_t* pSize)
 {
     error_t retCode = ERROR_OK;
+    struct stat st = {0};
 
     // open the shared memory
     *pFd = shm_open(SHAREDMEM_FILE, O_RDWR, 0600);
 
+    if (*pFd < 0)
+    {
+        *pFd = open(SHAREDMEM_HUGE_DIR "/" SHAREDMEM_FILE, O_RDWR);
+    }
+
     // check if the opening was successful
     if (*pFd < 0)
     {
@@ -157,8 +278,18 @@ static error_t init_shmem(shared_mem_t** pSharedMem, int16_t* pFd)
         return retCode;
     }
 
+    // the supervisor sized the memory before the generators were started
+    if ((fstat(*pFd, &st) < 0) || ((size_t)st.st_size < sizeof(shared_mem_t)))
+    {
+        close(*pFd);
+        debug("Shared memory has no valid size\n", NULL);
+        return ERROR_SHMEM;
+    }
+
+    *pSize = (size_t)st.st_size;
+
     // map the shared memory
-    *pSharedMem = (shared_mem_t*)mmap(NULL, sizeof(shared_mem_t), PROT_READ | PROT_WRITE, MAP_SHARED, *pFd, 0);
+    *pSharedMem = (shared_mem_t*)mmap(NULL, *pSize, PROT_READ | PROT_WRITE, MAP_SHARED, *pFd, 0);
 
     // check if the mapping was successful
     if (MAP_FAILED == *pSharedMem)
@@ -173,235 +304,11 @@ static error_t init_shmem(shared_mem_t** pSharedMem, int16_t* pFd)
     return retCode;
 }
 
-/**
- * @brief   Write Solution
- * @details This internal method is used to write a solution to the shared memory.
- *          It is called when a solution was found. It uses semaphores to synchronize the access to the shared memory.
- *          So that two different solutions get mixed up. Each solution is separated by a delimiter-edge.
- *
- * @param   pSharedMem  Pointer to the struct of shared memory
- * @param   pSems       Pointer to the struct of semaphores
- * @param   pEdges      Pointer to the array of edges
- * @param   edgeCnt     Number of edges
- * @param   pWritten    Pointer where written edges get written to
- *
- * @return  retCode     Error code
- * @retval  ERROR_OK            Everything went fine
- * @retval  ERROR_SEMAPHORE     Something went wrong with the semaphores
- */
-static error_t write_solution(shared_mem_t* pSharedMem, sems_t* pSems, edge_t* pEdges, size_t edgeCnt, size_t* pWritten)
-{
-    error_t retCode = ERROR_OK;                        /*!< return code for error handling */
-    edge_t del = {DELIMITER_VERTEX, DELIMITER_VERTEX}; /*!< delimiter edge, gets written at the end */
-
-    *pWritten = 0U;  // reset the number of written edges
-
-    if (sem_wait(pSems->mutex_write) < 0) return ERROR_SEMAPHORE;
-
-    for (size_t i = 0U; i < edgeCnt; i++)
-    {
-        // only write edges that are not the delimiter, or default
-        if (!is_edge_delimiter(pEdges[i]))
-        {
-            retCode |= circular_buffer_write(&pSharedMem->circbuf, pSems, &pEdges[i]);
-
-            if (ERROR_OK != retCode)
-            {
-                debug("Error while writing\n", NULL);
-                return retCode;
-            }
-            else
-            {
-                // actual size
-                *pWritten += 1U;
-            }
-            
-        }
-    }
-
-    // write the delimiter
-    retCode |= circular_buffer_write(&pSharedMem->circbuf, pSems, &del);
-
-    // increase the number of solutions
-    pSharedMem->flags.numSols++;
-
-    if (sem_post(pSems->mutex_write) < 0) return ERROR_SEMAPHORE;
-
-    return retCode;
-}
-
-/**
- * @brief   Get Vertices
- * @details This internal method is used to get all vertices from the edges.
- *          The array for the vertices is allocated with the worstcase (2x edges).
- *
- * @param   pEdges      Pointer to the array of edges
- * @param   edgeCnt     Number of edges
- * @param   pVertCnt    Pointer to the number of vertices
- *
- * @return  vert        Pointer to the array of vertices
- */
-static int16_t* get_vertices(edge_t* pEdges, size_t edgeCnt, size_t* pVertCnt)
-{
-    int16_t* vert = malloc(sizeof(int16_t) * edgeCnt * 2);
-    memset(vert, -1, sizeof(int16_t) * edgeCnt * 2);
-
-    bool* isIncl = malloc(sizeof(bool) * edgeCnt * 2);
-    memset(isIncl, false, sizeof(bool) * edgeCnt * 2);
-
-    size_t vertCnt = 0U;
-
-    for (size_t i = 0; i < edgeCnt; i++)
-    {
-        edge_t currEdge = pEdges[i];
-
-        if (!isIncl[currEdge.start])
-        {
-            vert[vertCnt] = currEdge.start;
-            vertCnt++;
-            isIncl[currEdge.start] = true;
-        }
-
-        if (!isIncl[currEdge.end])
-        {
-            vert[vertCnt] = currEdge.end;
-            vertCnt++;
-            isIncl[currEdge.end] = true;
-        }
-    }
-
-    // set the number of vertices
-    *pVertCnt = vertCnt;
-
-    free(isIncl);
-    return vert;
-}
-
-/**
- * @brief   Get Random Seed
- * @details This internal method is used to get a random seed from the pid
- *
- * @return  seed        Random seed
- */
-static uint16_t get_random_seed()
-{
-    return getpid();
-}
-
-/**
- * @brief   Shuffle
- * @details This internal method is used to shuffle the vertices.
- *          It reads the edges and writes them to the same array, but in a random order.
- *
- * @param   pVert       Pointer to the array of vertices (read and write)
- * @param   vertCnt     Number of vertices
- */
-static void shuffle(int16_t pVert[], size_t vertCnt)
-{
-    // mix the vertices in the array
-    for (size_t i = 0U; i < vertCnt; i++)
-    {
-        size_t j = rand() % vertCnt;
-        int16_t temp = (pVert)[i];
-        (pVert)[i] = (pVert)[j];
-        (pVert)[j] = temp;
-    }
-}
-
-/**
- * @brief   Sortout Solution
- * @details This internal method is used to sort out the solution.
- *         It reads the edges and writes them to the same array, but removes all edges which
- *         have a smaller index for the start vertex than the end vertex. The index of the vertices
- *         is generated by the shuffle method.
- *
- * @note   It uses a temporary array to store the edges, because it is easier. Later the edges get copied back.
- *
- * @param   pEdges      Pointer to the array of edges (read and write)
- * @param   edgeCnt     Number of edges
- * @param   pVert       Pointer to the array of vertices
- * @param   vertCnt     Number of vertices
- * @param   pSolSize    Number of edges in the solution
- */
-static error_t sortout_solution(edge_t pEdges[], size_t edgeCnt, int16_t* pVert, size_t vertCnt)
-{
-    edge_t* temp = calloc(sizeof(edge_t), edgeCnt);
-    uint16_t idxV1 = 0U;
-    uint16_t idxV2 = 0U;
-    size_t tempIdx = 0U;
-
-    for (size_t i = 0U; i < edgeCnt; i++)
-    {
-        edge_t currEdge = pEdges[i];
-
-        // search for the indexes of the vertices
-        for (size_t j = 0U; j < vertCnt; j++)
-        {
-            if (pVert[j] == currEdge.start)
-            {
-                idxV1 = j;
-            }
-
-            if (pVert[j] == currEdge.end)
-            {
-                idxV2 = j;
-            }
-        }
-
-        // check if this sge should be added to the solution (deletion set)
-        if (idxV1 > idxV2)
-        {
-            temp[tempIdx] = currEdge;
-            tempIdx++;
-        }
-
-        if(MAX_SOL_SIZE < tempIdx)
-        {
-            free(temp);
-            return ERROR_LIMIT;
-        }
-    }
-
-    memset(pEdges, 0, sizeof(edge_t) * edgeCnt);
-    memcpy(pEdges, temp, sizeof(edge_t) * edgeCnt);
-    free(temp);
-
-    return ERROR_OK;
-}
-
-/**
- * @brief   Generate Solution
- * @details This internal method is used to generate a solution.
- *
- * @param   pOrigEdges  Pointer to the array of edges (read only)
- * @param   pSolution   Pointer to the array of edges (read and write)
- * @param   edgeCnt     Number of edges
- * @param   pVert       Pointer to the array of vertices
- * @param   vertCnt     Number of vertices
- *
- * @return  retCode     Error code
- * @retval  ERROR_OK            Everything went fine
- */
-static error_t generate_solution(edge_t* pOrigEdges, edge_t* pSolution, size_t edgeCnt, int16_t* pVert, size_t vertCnt)
-{
-    error_t retCode = ERROR_OK; /*!< return code for error handling */
-
-    // reset the solution
-    memcpy(pSolution, pOrigEdges, sizeof(edge_t) * edgeCnt);
-
-    // shuffle the edges
-    shuffle(pVert, vertCnt);
-
-    // remove the edges which have a smaller index for the start vertex than the end vertex
-    retCode |= sortout_solution(pSolution, edgeCnt, pVert, vertCnt);
-
-    return retCode;
-}
-
 /**
  * @brief   Main
  * @details This is the main method of the application.
- *          It is used to read the edges from the parameters, generate a solution and write it to the shared memory.
+ *          It is used to read the edges from the parameters or a file, generate a solution and write it to the shared memory.
+ *          Without any edges the graph which the supervisor loaded from a file is used.
  *          These solutions are randomly generated. The supervisor will read them and check if they are better than the current best solution.
  *          If the given graph is acyclic, the generator will terminate. The supervisor will get this because a solution with 0 edges is written.
  *          Else only the supervisor can terminate the generators by a flag in the shared memory.
@@ -417,19 +324,48 @@ int main(int argc, char* argv[])
 {
     debug("This is the generator\n", NULL);
     error_t retCode = ERROR_OK;                          /*!< return code for error handling */
-    size_t edgeCnt = argc - 1U;                         /*!< number of given edges */
-    edge_t* edges = malloc(sizeof(edge_t) * edgeCnt);    /*!< memory to store all edges */
-    edge_t* solution = malloc(sizeof(edge_t) * edgeCnt); /*!< memory to store a solution */
+    options_t opts = {0U};                               /*!< bundle of options */
+    search_t search;                                     /*!< bundle of the search */
+    search_config_t config = {0};                        /*!< configuration of the search */
+    size_t edgeCnt = 0U;                                 /*!< number of given edges */
+    edge_t* edges = NULL;                                /*!< memory to store all edges */
     sems_t semaphores = {0U};                            /*!< struct of all needed semaphores */
     shared_mem_t* pSharedMem = NULL;
+    shared_mem_circbuf_t* pCirBuf = NULL;                 /*!< circular buffer (lane) to write to */
     int16_t fd = -1;
-    size_t solSize = 0U;
+    size_t shmSize = 0U;                                  /*!< size of the mapping of the shared memory */
 
     // set the application name
     gAppName = argv[0];
 
-    // read the edges from the parameters
-    readEdges(&edges, argv, argc);
+    /* get the options, the edges follow them */
+    handle_opts(argc, argv, &opts);
+
+    if ((NULL != opts.pFile) && !graph_file_is_image(opts.pFile))
+    {
+        retCode |= edgeparse_file(opts.pFile, &edges, &edgeCnt);
+
+        if (ERROR_OK != retCode)
+        {
+            emit_error("Something went wrong with reading the file\n", retCode);
+        }
+    }
+    else if (optind < argc)
+    {
+        edgeCnt = argc - optind;
+        edges = malloc(sizeof(edge_t) * edgeCnt);
+
+        if (NULL == edges)
+        {
+            emit_error("Something was wrong with allocating memory\n", ERROR_NULLPTR);
+        }
+
+        // read the edges from the parameters, readEdges skips the first element
+        readEdges(&edges, &argv[optind - 1], edgeCnt + 1U);
+    }
+
+    // without edges the graph is taken from the binary graph file or from the supervisor (shared graph)
+    check_edges(edges, edgeCnt);
 
     retCode |= init_semaphores(&semaphores);
 
@@ -439,7 +375,7 @@ int main(int argc, char* argv[])
         emit_error("Something was wrong with the semaphores\n", retCode);
     }
 
-    retCode |= init_shmem(&pSharedMem, &fd);
+    retCode |= init_shmem(&pSharedMem, &fd, &shmSize);
 
     if (ERROR_OK != retCode)
     {
@@ -447,51 +383,34 @@ int main(int argc, char* argv[])
         emit_error("Something was wrong with the shared memory\n", retCode);
     }
 
-    // set the seed for the random number generator
-    srand(get_random_seed());
-
-    size_t vertCnt = 0;
+    retCode |= circular_buffer_attach(pSharedMem, &pCirBuf);
 
-    // get the vertices
-    int16_t* pVert = get_vertices(edges, edgeCnt, &vertCnt);
-
-    while (pSharedMem->flags.genActive)
+    if (ERROR_OK != retCode)
     {
-        // generate the solution
-        retCode |= generate_solution(edges, solution, edgeCnt, pVert, vertCnt);
-
-        // if the generated solution is too big, continue with new solution
-        if (ERROR_LIMIT == retCode)
-        {
-            // reset status
-            retCode = ERROR_OK;
-            continue;
-        }
-        
-
-        // write the edges to the shared memory
-        retCode |= write_solution(pSharedMem, &semaphores, solution, edgeCnt, &solSize);
-
+        cleanup_semaphores(&semaphores);
+        emit_error("No free circular buffer lane left\n", retCode);
+    }
 
-        if (ERROR_OK != retCode)
-        {
-            debug_pid("Exited because of error %d", retCode);
-            break;
-        }
+    // only now, the shared graph must not be created without a running supervisor which removes it at the end
+    config.localSearch = opts.localSearch;
+    config.greedy = opts.greedy;
+    config.pFile = opts.pFile;
+    config.bnbThreads = opts.bnbThreads;
+    backedges_init();
 
-        // check if the solution is empty, this means termination
-        if (0U == solSize)
-        {
-            debug_pid("Solution with 0 edges found, terminating now, supervise will terminate too\n", NULL);
-            break;
-        }
+    if (ERROR_OK != search_init(&search, edges, edgeCnt, NULL, &config))
+    {
+        cleanup_semaphores(&semaphores);
+        emit_error("Something was wrong with loading the graph\n", ERROR_NULLPTR);
     }
 
-    if (false == pSharedMem->flags.genActive)
+    retCode |= search_run(&search, pSharedMem, pCirBuf, &semaphores);
+
+    if (ERROR_NULLPTR == retCode)
     {
-        debug_pid("Terminating because of flag\n", NULL);
+        cleanup_semaphores(&semaphores);
+        emit_error("Something was wrong with allocating memory\n", ERROR_NULLPTR);
     }
-    
 
     if ((retCode & ERROR_SIGINT) != 0)
     {
@@ -501,12 +420,11 @@ int main(int argc, char* argv[])
     }
     
 
-    // unmap memory
-    munmap(pSharedMem, sizeof(shared_mem_t));
+    // give back the lane and unmap memory
+    circular_buffer_detach(pCirBuf);
+    munmap(pSharedMem, shmSize);
     cleanup_semaphores(&semaphores);
-    free(pVert);
-    free(edges);
-    free(solution);
+    search_cleanup(&search);
 
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,772 @@
+#include "graph.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @file graph.c
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ */
+
+/**
+ * @brief       Compare Vertices
+ * @details     This internal method is used to sort the vertex ids (qsort).
+ *
+ * @param       pA      Pointer to the first vertex
+ * @param       pB      Pointer to the second vertex
+ *
+ * @return      <0, 0 or >0 like strcmp
+ */
+static int compare_vertices(const void* pA, const void* pB)
+{
+    vertex_t a = *(const vertex_t*)pA;
+    vertex_t b = *(const vertex_t*)pB;
+
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief       Dense Id
+ * @details     This internal method is used to find the dense index of a vertex id (binary search).
+ *
+ * @param       pIds        Pointer to the sorted vertex ids
+ * @param       vertCnt     Number of vertex ids
+ * @param       id          Vertex id, has to be part of pIds
+ *
+ * @return      Dense index of the vertex
+ */
+static vertex_t dense_id(const vertex_t* pIds, size_t vertCnt, vertex_t id)
+{
+    size_t low = 0U;
+    size_t high = vertCnt;
+
+    while (low < high)
+    {
+        size_t mid = low + ((high - low) / 2U);
+
+        if (pIds[mid] < id)
+        {
+            low = mid + 1U;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return (vertex_t)low;
+}
+
+/**
+ * @brief       Graph Compact
+ * @details     This method is used to map the vertex ids into a dense id space (0 .. vertCnt - 1).
+ *              The ids can be sparse and as big as VERTEX_MAX, after this every array indexed by a vertex only needs
+ *              one element per vertex. The dense index of a vertex is its rank among the sorted ids.
+ *
+ * @param       pEdges      Pointer to the array of edges (original ids)
+ * @param       edgeCnt     Number of edges
+ * @param       pDense      Pointer to the array where the edges with dense ids get written to (may be pEdges)
+ * @param       ppIds       Pointer where the (allocated) table dense index -> original id gets written to
+ * @param       pVertCnt    Pointer where the number of vertices gets written to
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ */
+error_t graph_compact(const edge_t* pEdges, size_t edgeCnt, edge_t* pDense, vertex_t** ppIds, size_t* pVertCnt)
+{
+    vertex_t* pIds = malloc(sizeof(vertex_t) * ((2U * edgeCnt) + 1U));
+    vertex_t* pShrunk = NULL;
+    size_t vertCnt = 0U;
+
+    if (NULL == pIds)
+    {
+        return ERROR_NULLPTR;
+    }
+
+    for (size_t i = 0U; i < edgeCnt; i++)
+    {
+        pIds[2U * i] = pEdges[i].start;
+        pIds[(2U * i) + 1U] = pEdges[i].end;
+    }
+
+    qsort(pIds, 2U * edgeCnt, sizeof(vertex_t), compare_vertices);
+
+    // remove the duplicates
+    for (size_t i = 0U; i < (2U * edgeCnt); i++)
+    {
+        if ((0U == vertCnt) || (pIds[vertCnt - 1U] != pIds[i]))
+        {
+            pIds[vertCnt] = pIds[i];
+            vertCnt++;
+        }
+    }
+
+    for (size_t i = 0U; i < edgeCnt; i++)
+    {
+        vertex_t start = dense_id(pIds, vertCnt, pEdges[i].start);
+        vertex_t end = dense_id(pIds, vertCnt, pEdges[i].end);
+
+        pDense[i].start = start;
+        pDense[i].end = end;
+    }
+
+    // give back what the duplicates needed
+    pShrunk = realloc(pIds, sizeof(vertex_t) * (vertCnt + 1U));
+
+    *ppIds = (NULL != pShrunk) ? pShrunk : pIds;
+    *pVertCnt = vertCnt;
+
+    return ERROR_OK;
+}
+
+/**
+ * @brief       Graph Create
+ * @details     This method is used to build the adjacency structure from a list of edges.
+ *              First the degrees are counted, the prefix sum of them are the offsets. After that every edge is
+ *              written to the lists of its start vertex (successors) and its end vertex (predecessors).
+ *
+ * @param       pEdges      Pointer to the array of edges
+ * @param       edgeCnt     Number of edges
+ * @param       idCnt       Size of the id space (biggest vertex id + 1)
+ * @param       pGraph      Pointer to the graph (write)
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ */
+error_t graph_create(const edge_t* pEdges, size_t edgeCnt, size_t idCnt, graph_t* pGraph)
+{
+    uint32_t* pOutFill = NULL;
+    uint32_t* pInFill = NULL;
+
+    memset(pGraph, 0, sizeof(graph_t));
+    pGraph->idCnt = idCnt;
+    pGraph->edgeCnt = edgeCnt;
+    pGraph->pOutOff = calloc(sizeof(uint32_t), idCnt + 1U);
+    pGraph->pInOff = calloc(sizeof(uint32_t), idCnt + 1U);
+    pGraph->pOut = malloc(sizeof(vertex_t) * (edgeCnt + 1U));
+    pGraph->pIn = malloc(sizeof(vertex_t) * (edgeCnt + 1U));
+    pOutFill = calloc(sizeof(uint32_t), idCnt + 1U);
+    pInFill = calloc(sizeof(uint32_t), idCnt + 1U);
+
+    if ((NULL == pGraph->pOutOff) || (NULL == pGraph->pInOff) || (NULL == pGraph->pOut) || (NULL == pGraph->pIn) ||
+        (NULL == pOutFill) || (NULL == pInFill))
+    {
+        free(pOutFill);
+        free(pInFill);
+        graph_free(pGraph);
+        return ERROR_NULLPTR;
+    }
+
+    // count the degrees, shifted by one so the prefix sum gives the offsets
+    for (size_t i = 0U; i < edgeCnt; i++)
+    {
+        pGraph->pOutOff[pEdges[i].start + 1U]++;
+        pGraph->pInOff[pEdges[i].end + 1U]++;
+    }
+
+    for (size_t v = 0U; v < idCnt; v++)
+    {
+        size_t deg = pGraph->pOutOff[v + 1U] + pGraph->pInOff[v + 1U];
+
+        if (deg > pGraph->maxDeg)
+        {
+            pGraph->maxDeg = deg;
+        }
+
+        pGraph->pOutOff[v + 1U] += pGraph->pOutOff[v];
+        pGraph->pInOff[v + 1U] += pGraph->pInOff[v];
+    }
+
+    // fill the lists
+    memcpy(pOutFill, pGraph->pOutOff, sizeof(uint32_t) * (idCnt + 1U));
+    memcpy(pInFill, pGraph->pInOff, sizeof(uint32_t) * (idCnt + 1U));
+
+    for (size_t i = 0U; i < edgeCnt; i++)
+    {
+        pGraph->pOut[pOutFill[pEdges[i].start]++] = pEdges[i].end;
+        pGraph->pIn[pInFill[pEdges[i].end]++] = pEdges[i].start;
+    }
+
+    free(pOutFill);
+    free(pInFill);
+
+    return ERROR_OK;
+}
+
+/**
+ * @brief       Graph Free
+ * @details     This method is used to free the memory of the adjacency structure.
+ *
+ * @param       pGraph      Pointer to the graph
+ */
+void graph_free(graph_t* pGraph)
+{
+    free(pGraph->pOutOff);
+    free(pGraph->pInOff);
+    free(pGraph->pOut);
+    free(pGraph->pIn);
+    memset(pGraph, 0, sizeof(graph_t));
+}
+
+/**
+ * @brief       Align
+ * @param       size    Size in byte
+ * @return      Size rounded up to a multiple of 8
+ */
+static size_t align8(size_t size) { return (size + 7U) & ~(size_t)7U; }
+
+/**
+ * @brief       Edges Checksum
+ * @details     This internal method is used to get a checksum (FNV-1a) of the edge list.
+ *
+ * @param       pEdges      Pointer to the array of edges
+ * @param       edgeCnt     Number of edges
+ *
+ * @return      Checksum
+ */
+static uint64_t edges_checksum(const edge_t* pEdges, size_t edgeCnt)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+
+    for (size_t i = 0U; i < edgeCnt; i++)
+    {
+        hash = (hash ^ pEdges[i].start) * 0x100000001B3ULL;
+        hash = (hash ^ pEdges[i].end) * 0x100000001B3ULL;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief       Image Size
+ * @details     This internal method is used to get the size of a graph image.
+ *
+ * @param       edgeCnt     Number of edges
+ * @param       vertCnt     Number of vertices
+ * @param       idCnt       Size of the id space
+ * @param       csr         The image contains the adjacency
+ *
+ * @return      Size in byte
+ */
+static size_t image_size(size_t edgeCnt, size_t vertCnt, size_t idCnt, bool csr)
+{
+    size_t size = align8(sizeof(graph_shm_header_t)) + (2U * align8(sizeof(vertex_t) * edgeCnt)) +
+                  align8(sizeof(vertex_t) * vertCnt);
+
+    if (csr)
+    {
+        size += (2U * align8(sizeof(vertex_t) * edgeCnt)) + (2U * align8(sizeof(uint32_t) * (idCnt + 1U)));
+    }
+
+    return size;
+}
+
+/**
+ * @brief       Image Check
+ * @details     This internal method is used to check if a mapping holds a complete graph image.
+ *
+ * @param       pHeader     Pointer to the header of the image
+ * @param       size        Size of the mapping
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        The image can be used
+ * @retval      ERROR_PARAM     It is no graph image at all
+ * @retval      ERROR_FILE      It is a graph image, but of another version or vertex width, not complete or too small
+ */
+static error_t image_check(const graph_shm_header_t* pHeader, size_t size)
+{
+    if (GRAPH_IMAGE_MAGIC != pHeader->magic)
+    {
+        return ERROR_PARAM;
+    }
+
+    if ((GRAPH_IMAGE_VERSION != pHeader->version) || (sizeof(vertex_t) != pHeader->vertSize) ||
+        (0U == __atomic_load_n(&pHeader->ready, __ATOMIC_ACQUIRE)) ||
+        (pHeader->size > size) ||
+        (image_size(pHeader->edgeCnt, pHeader->vertCnt, pHeader->idCnt, 0U != (pHeader->flags & GRAPH_IMAGE_CSR)) >
+         pHeader->size))
+    {
+        return ERROR_FILE;
+    }
+
+    return ERROR_OK;
+}
+
+/**
+ * @brief       Graph SHM Layout
+ * @details     This internal method is used to set all pointers of the mapping from the header.
+ *              Without the adjacency in the image the pointers of the graph stay NULL.
+ *
+ * @param       pShm        Pointer to the mapping (pBase has to be set)
+ */
+static void graph_shm_layout(graph_shm_t* pShm)
+{
+    const graph_shm_header_t* pHeader = pShm->pBase;
+    uint8_t* pCurr = (uint8_t*)pShm->pBase + align8(sizeof(graph_shm_header_t));
+
+    pShm->pStart = (const vertex_t*)pCurr;
+    pCurr += align8(sizeof(vertex_t) * pHeader->edgeCnt);
+    pShm->pEnd = (const vertex_t*)pCurr;
+    pCurr += align8(sizeof(vertex_t) * pHeader->edgeCnt);
+    pShm->pIds = (const vertex_t*)pCurr;
+    pCurr += align8(sizeof(vertex_t) * pHeader->vertCnt);
+
+    if (0U != (pHeader->flags & GRAPH_IMAGE_CSR))
+    {
+        pShm->graph.pOutOff = (uint32_t*)pCurr;
+        pCurr += align8(sizeof(uint32_t) * (pHeader->idCnt + 1U));
+        pShm->graph.pOut = (vertex_t*)pCurr;
+        pCurr += align8(sizeof(vertex_t) * pHeader->edgeCnt);
+        pShm->graph.pInOff = (uint32_t*)pCurr;
+        pCurr += align8(sizeof(uint32_t) * (pHeader->idCnt + 1U));
+        pShm->graph.pIn = (vertex_t*)pCurr;
+    }
+
+    pShm->graph.idCnt = pHeader->idCnt;
+    pShm->graph.edgeCnt = pHeader->edgeCnt;
+    pShm->graph.maxDeg = pHeader->maxDeg;
+    pShm->vertCnt = pHeader->vertCnt;
+}
+
+/**
+ * @brief       Graph SHM Fill
+ * @details     This internal method is used by the creator of an image to write the graph into it.
+ *              The ready flag is set at last, after that the image is only read.
+ *
+ * @param       pShm        Pointer to the mapping (writable)
+ * @param       pDense      Pointer to the array of edges (dense ids)
+ * @param       edgeCnt     Number of edges
+ * @param       pIds        Pointer to the original ids of the vertices
+ * @param       pGraph      Pointer to the (private) adjacency of the graph, NULL if the image has none
+ */
+static void graph_shm_fill(graph_shm_t* pShm, const edge_t* pDense, size_t edgeCnt, const vertex_t* pIds,
+                           const graph_t* pGraph)
+{
+    graph_shm_header_t* pHeader = pShm->pBase;
+    vertex_t* pStart = NULL;
+    vertex_t* pEnd = NULL;
+
+    graph_shm_layout(pShm);
+    pStart = (vertex_t*)pShm->pStart;
+    pEnd = (vertex_t*)pShm->pEnd;
+
+    for (size_t i = 0U; i < edgeCnt; i++)
+    {
+        pStart[i] = pDense[i].start;
+        pEnd[i] = pDense[i].end;
+    }
+
+    memcpy((vertex_t*)pShm->pIds, pIds, sizeof(vertex_t) * pHeader->vertCnt);
+
+    if (NULL != pGraph)
+    {
+        memcpy(pShm->graph.pOutOff, pGraph->pOutOff, sizeof(uint32_t) * (pGraph->idCnt + 1U));
+        memcpy(pShm->graph.pOut, pGraph->pOut, sizeof(vertex_t) * edgeCnt);
+        memcpy(pShm->graph.pInOff, pGraph->pInOff, sizeof(uint32_t) * (pGraph->idCnt + 1U));
+        memcpy(pShm->graph.pIn, pGraph->pIn, sizeof(vertex_t) * edgeCnt);
+    }
+
+    __atomic_store_n(&pHeader->ready, 1U, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief       Image Write
+ * @details     This internal method is used to write the image of a graph to a file descriptor (shared memory or
+ *              regular file). The file gets resized and mapped, the mapping stays read-only in pShm. Without a file
+ *              descriptor the image is written to private anonymous memory.
+ *              The vertices get compacted, the image only holds dense ids and the table back to the original ones.
+ *
+ * @param       fd          File descriptor, opened for reading and writing, -1 for private memory
+ * @param       pEdges      Pointer to the array of edges (original ids)
+ * @param       edgeCnt     Number of edges
+ * @param       csr         Put the adjacency into the image too
+ * @param       pShm        Pointer to the mapping (write)
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_FILE      The file could not be resized or mapped
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ */
+static error_t image_write(int fd, const edge_t* pEdges, size_t edgeCnt, bool csr, graph_shm_t* pShm)
+{
+    error_t retCode = ERROR_OK;
+    graph_shm_header_t* pHeader = NULL;
+    graph_t graph = {0};
+    size_t vertCnt = 0U;
+    vertex_t* pIds = NULL;
+    edge_t* pDense = malloc(sizeof(edge_t) * (edgeCnt + 1U));
+
+    retCode |= (NULL == pDense) ? ERROR_NULLPTR : graph_compact(pEdges, edgeCnt, pDense, &pIds, &vertCnt);
+
+    if (csr && (ERROR_OK == retCode))
+    {
+        retCode |= graph_create(pDense, edgeCnt, vertCnt, &graph);
+    }
+
+    if (ERROR_OK == retCode)
+    {
+        pShm->size = image_size(edgeCnt, vertCnt, vertCnt, csr);
+
+        if ((fd >= 0) && (ftruncate(fd, pShm->size) < 0))
+        {
+            retCode |= ERROR_FILE;
+        }
+    }
+
+    if (ERROR_OK == retCode)
+    {
+        pShm->pBase = mmap(NULL, pShm->size, PROT_READ | PROT_WRITE,
+                           (fd >= 0) ? MAP_SHARED : (MAP_PRIVATE | MAP_ANONYMOUS), fd, 0);
+        retCode |= (MAP_FAILED == pShm->pBase) ? ERROR_FILE : ERROR_OK;
+    }
+
+    if (ERROR_OK == retCode)
+    {
+        pHeader = pShm->pBase;
+        pHeader->magic = GRAPH_IMAGE_MAGIC;
+        pHeader->version = GRAPH_IMAGE_VERSION;
+        pHeader->flags = csr ? GRAPH_IMAGE_CSR : 0U;
+        pHeader->checksum = edges_checksum(pEdges, edgeCnt);
+        pHeader->vertSize = sizeof(vertex_t);
+        pHeader->edgeCnt = edgeCnt;
+        pHeader->idCnt = vertCnt;
+        pHeader->vertCnt = vertCnt;
+        pHeader->maxDeg = graph.maxDeg;
+        pHeader->size = pShm->size;
+
+        graph_shm_fill(pShm, pDense, edgeCnt, pIds, csr ? &graph : NULL);
+
+        // nobody writes to the graph anymore
+        mprotect(pShm->pBase, pShm->size, PROT_READ);
+    }
+    else
+    {
+        pShm->pBase = NULL;
+    }
+
+    free(pDense);
+    free(pIds);
+    graph_free(&graph);
+
+    return retCode;
+}
+
+/**
+ * @brief       Graph SHM Create
+ * @details     This internal method is used by the first generator to create the shared graph.
+ *              The segment is created exclusively, so only one generator can be the creator.
+ *
+ * @param       pEdges      Pointer to the array of edges
+ * @param       edgeCnt     Number of edges
+ * @param       pShm        Pointer to the mapping (write)
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_SHMEM     The segment already exists or could not be created
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ */
+static error_t graph_shm_create(const edge_t* pEdges, size_t edgeCnt, graph_shm_t* pShm)
+{
+    error_t retCode = ERROR_OK;
+    int fd = -1;
+
+    fd = shm_open(GRAPH_SHM_FILE, O_RDWR | O_CREAT | O_EXCL, 0600);
+
+    if (fd < 0)
+    {
+        return ERROR_SHMEM;
+    }
+
+    retCode = image_write(fd, pEdges, edgeCnt, true, pShm);
+
+    if (ERROR_OK != retCode)
+    {
+        // do not leave a half created graph behind, the others would wait for it
+        shm_unlink(GRAPH_SHM_FILE);
+        retCode = (ERROR_NULLPTR == retCode) ? ERROR_NULLPTR : ERROR_SHMEM;
+    }
+
+    close(fd);
+
+    return retCode;
+}
+
+/**
+ * @brief       Graph SHM Open
+ * @details     This internal method is used to map the shared graph, which was created by another generator.
+ *              It waits until the creator is done and checks that the graph is the same as the given one.
+ *
+ * @param       pEdges      Pointer to the array of edges, NULL takes the graph without checking it
+ * @param       edgeCnt     Number of edges
+ * @param       pShm        Pointer to the mapping (write)
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_SHMEM     The segment could not be mapped, was not ready in time or holds another graph
+ */
+static error_t graph_shm_open(const edge_t* pEdges, size_t edgeCnt, graph_shm_t* pShm)
+{
+    const struct timespec delay = {.tv_sec = 0, .tv_nsec = 1000000L}; /*!< 1ms */
+    graph_shm_header_t* pHeader = NULL;
+    struct stat st = {0};
+    int fd = -1;
+
+    fd = shm_open(GRAPH_SHM_FILE, O_RDONLY, 0600);
+
+    if (fd < 0)
+    {
+        return ERROR_SHMEM;
+    }
+
+    // the size is set by the creator before anything else
+    for (size_t i = 0U; i < GRAPH_SHM_WAIT_MS; i++)
+    {
+        if ((fstat(fd, &st) == 0) && ((size_t)st.st_size >= sizeof(graph_shm_header_t)))
+        {
+            break;
+        }
+        nanosleep(&delay, NULL);
+    }
+
+    if ((size_t)st.st_size < sizeof(graph_shm_header_t))
+    {
+        close(fd);
+        return ERROR_SHMEM;
+    }
+
+    pShm->size = (size_t)st.st_size;
+    pShm->pBase = mmap(NULL, pShm->size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (MAP_FAILED == pShm->pBase)
+    {
+        pShm->pBase = NULL;
+        return ERROR_SHMEM;
+    }
+
+    pHeader = pShm->pBase;
+
+    for (size_t i = 0U; (i < GRAPH_SHM_WAIT_MS) && (0U == __atomic_load_n(&pHeader->ready, __ATOMIC_ACQUIRE)); i++)
+    {
+        nanosleep(&delay, NULL);
+    }
+
+    if ((ERROR_OK != image_check(pHeader, pShm->size)) ||
+        ((NULL != pEdges) &&
+         ((pHeader->edgeCnt != edgeCnt) || (pHeader->checksum != edges_checksum(pEdges, edgeCnt)))))
+    {
+        graph_shm_detach(pShm);
+        return ERROR_SHMEM;
+    }
+
+    graph_shm_layout(pShm);
+
+    return ERROR_OK;
+}
+
+/**
+ * @brief       Graph SHM Attach
+ * @details     This method is used to get the graph from the shared memory, so that it is only stored once no matter
+ *              how many generators are running. The first generator creates the segment, all others map it
+ *              read-only. The supervisor removes the segment at the end.
+ *              If the supervisor got the graph from a file, it creates the segment itself and the generators can
+ *              take the graph from it without any edges (pEdges is NULL).
+ *
+ * @param       pEdges      Pointer to the array of edges (only read to create the segment or to compare it), or NULL
+ * @param       edgeCnt     Number of edges
+ * @param       pShm        Pointer to the mapping (write)
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_SHMEM     The shared graph cannot be used, the caller has to use a private copy
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ */
+error_t graph_shm_attach(const edge_t* pEdges, size_t edgeCnt, graph_shm_t* pShm)
+{
+    error_t retCode = ERROR_OK;
+
+    memset(pShm, 0, sizeof(graph_shm_t));
+
+    if (NULL == pEdges)
+    {
+        return graph_shm_open(NULL, 0U, pShm);
+    }
+
+    retCode = graph_shm_create(pEdges, edgeCnt, pShm);
+
+    if ((ERROR_SHMEM == retCode) && (EEXIST == errno))
+    {
+        retCode = graph_shm_open(pEdges, edgeCnt, pShm);
+    }
+
+    return retCode;
+}
+
+/**
+ * @brief       Graph Private Create
+ * @details     This method is used to build the same image as the shared graph in private memory, for a process
+ *              which keeps its graph to itself (generator threads). Nothing is opened in the file system.
+ *
+ * @param       pEdges      Pointer to the array of edges
+ * @param       edgeCnt     Number of edges
+ * @param       pShm        Pointer to the mapping (write), it is freed with graph_shm_detach
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_FILE      The memory could not be mapped
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ */
+error_t graph_private_create(const edge_t* pEdges, size_t edgeCnt, graph_shm_t* pShm)
+{
+    memset(pShm, 0, sizeof(graph_shm_t));
+
+    return image_write(-1, pEdges, edgeCnt, true, pShm);
+}
+
+/**
+ * @brief       Graph SHM Detach
+ * @details     This method is used to unmap the shared graph or a graph file.
+ *
+ * @param       pShm        Pointer to the mapping
+ */
+void graph_shm_detach(graph_shm_t* pShm)
+{
+    if (NULL != pShm->pBase)
+    {
+        munmap(pShm->pBase, pShm->size);
+    }
+
+    memset(pShm, 0, sizeof(graph_shm_t));
+}
+
+/**
+ * @brief       Graph File Write
+ * @details     This method is used to write a graph to a binary file. The file is the same image as the shared
+ *              graph, so it can be mapped and used without any parsing.
+ *
+ * @param       pPath       Path to the file, gets overwritten
+ * @param       pEdges      Pointer to the array of edges
+ * @param       edgeCnt     Number of edges
+ * @param       csr         Put the adjacency into the file too
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_FILE      The file could not be written
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ */
+error_t graph_file_write(const char* pPath, const edge_t* pEdges, size_t edgeCnt, bool csr)
+{
+    error_t retCode = ERROR_OK;
+    graph_shm_t image = {0};
+    int fd = open(pPath, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    if (fd < 0)
+    {
+        return ERROR_FILE;
+    }
+
+    retCode = image_write(fd, pEdges, edgeCnt, csr, &image);
+
+    if ((ERROR_OK == retCode) && (msync(image.pBase, image.size, MS_SYNC) < 0))
+    {
+        retCode |= ERROR_FILE;
+    }
+
+    graph_shm_detach(&image);
+    close(fd);
+
+    return retCode;
+}
+
+/**
+ * @brief       Graph File Map
+ * @details     This method is used to map a binary graph file read-only. Nothing gets parsed or copied, all pointers
+ *              of the mapping point into the file. If the file has no adjacency, the pointers of the graph are NULL.
+ *
+ * @param       pPath       Path to the file
+ * @param       pShm        Pointer to the mapping (write), has to be freed with graph_shm_detach
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_PARAM     The file is no binary graph (but may be a text file)
+ * @retval      ERROR_FILE      The file could not be mapped or is broken
+ */
+error_t graph_file_map(const char* pPath, graph_shm_t* pShm)
+{
+    error_t retCode = ERROR_OK;
+    struct stat st = {0};
+    int fd = open(pPath, O_RDONLY);
+
+    memset(pShm, 0, sizeof(graph_shm_t));
+
+    if (fd < 0)
+    {
+        return ERROR_FILE;
+    }
+
+    if ((fstat(fd, &st) < 0) || !S_ISREG(st.st_mode) || ((size_t)st.st_size < sizeof(graph_shm_header_t)))
+    {
+        close(fd);
+        return ERROR_PARAM;
+    }
+
+    pShm->size = (size_t)st.st_size;
+    pShm->pBase = mmap(NULL, pShm->size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (MAP_FAILED == pShm->pBase)
+    {
+        pShm->pBase = NULL;
+        return ERROR_FILE;
+    }
+
+    retCode = image_check(pShm->pBase, pShm->size);
+
+    if (ERROR_OK != retCode)
+    {
+        graph_shm_detach(pShm);
+        return retCode;
+    }
+
+    graph_shm_layout(pShm);
+
+    return ERROR_OK;
+}
+
+/**
+ * @brief       Graph File Is Image
+ * @details     This method is used to check if a file is a binary graph file, only the magic number is read.
+ *
+ * @param       pPath       Path to the file
+ *
+ * @return      true if the file starts like a graph image
+ */
+bool graph_file_is_image(const char* pPath)
+{
+    uint32_t magic = 0U;
+    int fd = open(pPath, O_RDONLY);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    if (read(fd, &magic, sizeof(magic)) != (ssize_t)sizeof(magic))
+    {
+        magic = 0U;
+    }
+
+    close(fd);
+
+    return GRAPH_IMAGE_MAGIC == magic;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+/**
+ * @file  graph.h
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ * @brief Adjacency structure of the graph
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common.h"
+#include "errors.h"
+
+/*!
+ * @struct graph_t
+ * @brief  Graph in compressed sparse row format
+ *
+ * @details The successors of vertex v are pOut[pOutOff[v]] .. pOut[pOutOff[v + 1] - 1], the predecessors are stored
+ *          the same way in pIn. Both are indexed by the vertex id.
+ **/
+typedef struct
+{
+    size_t idCnt;      /*!< size of the id space (biggest vertex id + 1), the number of vertices for dense ids */
+    size_t edgeCnt;    /*!< number of edges */
+    size_t maxDeg;     /*!< biggest sum of in- and out-degree of a vertex */
+    uint32_t* pOutOff; /*!< offsets into pOut, idCnt + 1 elements */
+    vertex_t* pOut;    /*!< successors, edgeCnt elements */
+    uint32_t* pInOff;  /*!< offsets into pIn, idCnt + 1 elements */
+    vertex_t* pIn;     /*!< predecessors, edgeCnt elements */
+} graph_t;
+
+#define GRAPH_SHM_WAIT_MS 5000U /*!< Maximum time to wait until the creator of the shared graph is done */
+
+#define GRAPH_IMAGE_MAGIC 0x47534146U /*!< "FASG" at the start of every graph image */
+#define GRAPH_IMAGE_VERSION 2U        /*!< version of the layout of the image */
+#define GRAPH_IMAGE_CSR 0x1U          /*!< flag: the image contains the adjacency */
+
+/*!
+ * @struct graph_shm_header_t
+ * @brief  Header of a graph image (the shared memory segment of the graph or a binary graph file)
+ *
+ * @details The arrays follow the header in this order (each aligned to 8 byte): start vertices, end vertices,
+ *          vertex ids and, only with GRAPH_IMAGE_CSR, out-offsets, successors, in-offsets, predecessors.
+ *          All vertices in the image are dense (0 .. vertCnt - 1), the vertex ids map them back to the original ids.
+ *          A binary graph file is a copy of the segment, so it can be mapped in the same way.
+ **/
+typedef struct
+{
+    uint32_t magic;    /*!< GRAPH_IMAGE_MAGIC */
+    uint32_t version;  /*!< GRAPH_IMAGE_VERSION */
+    uint32_t ready;    /*!< set (atomic) by the creator after everything was written */
+    uint32_t flags;    /*!< GRAPH_IMAGE_CSR if the adjacency is part of the image */
+    uint64_t checksum; /*!< checksum of the edge list, to detect generators with a different graph */
+    uint64_t vertSize; /*!< size of a vertex in byte, images of a build with another width cannot be used */
+    uint64_t edgeCnt;  /*!< number of edges */
+    uint64_t idCnt;    /*!< size of the id space */
+    uint64_t vertCnt;  /*!< number of vertices */
+    uint64_t maxDeg;   /*!< biggest sum of in- and out-degree of a vertex */
+    uint64_t size;     /*!< size of the whole segment */
+} graph_shm_header_t;
+
+/*!
+ * @struct graph_shm_t
+ * @brief  Mapping of the shared graph
+ *
+ * @details All pointers point into the read-only mapping, nothing of it may be freed.
+ **/
+typedef struct
+{
+    void* pBase;            /*!< start of the mapping */
+    size_t size;            /*!< size of the mapping */
+    graph_t graph;          /*!< adjacency of the graph, the pointers are NULL if the image has none */
+    const vertex_t* pStart; /*!< start vertices of the edges (dense) */
+    const vertex_t* pEnd;   /*!< end vertices of the edges (dense) */
+    const vertex_t* pIds;   /*!< original id of every vertex (dense index -> vertex id) */
+    size_t vertCnt;         /*!< number of vertices */
+} graph_shm_t;
+
+/* **** FUNCTIONS **** */
+error_t graph_compact(const edge_t* pEdges, size_t edgeCnt, edge_t* pDense, vertex_t** ppIds, size_t* pVertCnt);
+error_t graph_create(const edge_t* pEdges, size_t edgeCnt, size_t idCnt, graph_t* pGraph);
+void graph_free(graph_t* pGraph);
+error_t graph_shm_attach(const edge_t* pEdges, size_t edgeCnt, graph_shm_t* pShm);
+error_t graph_private_create(const edge_t* pEdges, size_t edgeCnt, graph_shm_t* pShm);
+void graph_shm_detach(graph_shm_t* pShm);
+error_t graph_file_write(const char* pPath, const edge_t* pEdges, size_t edgeCnt, bool csr);
+error_t graph_file_map(const char* pPath, graph_shm_t* pShm);
+bool graph_file_is_image(const char* pPath);
@@ -0,0 +1,107 @@
+/**
+ * @file graphconv.c
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ * @brief Converter from the text edge list to the binary graph file
+ */
+
+#include <getopt.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "common.h"
+#include "debug.h"
+#include "edgeparse.h"
+#include "errors.h"
+#include "graph.h"
+
+static const char* gAppName; /*!< Name of the application */
+
+/**
+ * @brief   Usage
+ * @details This internal method is used to print the usage message and exit the application.
+ * @param   msg     Message which will be printed
+ */
+static void usage(char* msg)
+{
+    // print the usage message
+    fprintf(stderr, "%s\nUsage: %s [-n] INPUT OUTPUT\n", msg, gAppName);
+    emit_error(msg, ERROR_PARAM);
+}
+
+/**
+ * @brief   Main
+ * @details This is the main method of the application.
+ *          It reads the edges from the text file INPUT ("-" for stdin) and writes them as binary graph file to OUTPUT.
+ *          The adjacency is written too, unless -n is given.
+ *
+ * @param   argc    Number of given parameters
+ * @param   argv    Array of given parameters by user
+ *
+ * @return  retCode Error code
+ * @retval  EXIT_SUCCESS    Everything went fine
+ * @retval  EXIT_FAILURE    Something went wrong
+ */
+int main(int argc, char* argv[])
+{
+    error_t retCode = ERROR_OK; /*!< return code for error handling */
+    bool csr = true;            /*!< write the adjacency too */
+    edge_t* edges = NULL;       /*!< all edges of the graph */
+    size_t edgeCnt = 0U;        /*!< number of edges */
+    int16_t ret = 0;
+
+    // set the application name
+    gAppName = argv[0];
+
+    while ((ret = getopt(argc, argv, "n")) != -1)
+    {
+        switch (ret)
+        {
+            // No adjacency
+            case 'n': {
+                csr = false;
+                break;
+            }
+
+            // Unknown option
+            default: {
+                usage("Unknown option\n");
+                break;
+            }
+        }
+    }
+
+    if (2 != (argc - optind))
+    {
+        usage("Input and output have to be given\n");
+    }
+
+    retCode |= edgeparse_file(argv[optind], &edges, &edgeCnt);
+
+    if (ERROR_OK != retCode)
+    {
+        emit_error("Something went wrong with reading the file\n", retCode);
+    }
+
+    for (size_t i = 0U; i < edgeCnt; i++)
+    {
+        // check for loop
+        if (edges[i].start == edges[i].end)
+        {
+            emit_error("Loops are not allowed\n", ERROR_PARAM);
+        }
+    }
+
+    retCode |= graph_file_write(argv[optind + 1], edges, edgeCnt, csr);
+    free(edges);
+
+    if (ERROR_OK != retCode)
+    {
+        emit_error("Something went wrong with writing the file\n", retCode);
+    }
+
+    debug("%zu edges written\n", edgeCnt);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,285 @@
+#include "greedy.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file greedy.c
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ */
+
+#define BUCKET_SINK 0U   /*!< bucket of the vertices without successors */
+#define BUCKET_SOURCE 1U /*!< bucket of the vertices without predecessors */
+#define BUCKET_FIRST 2U  /*!< first bucket of the out-degree minus in-degree */
+
+/**
+ * @brief       Bucket Of
+ * @details     This internal method is used to get the bucket a vertex belongs to.
+ *
+ * @param       pGreedy     Pointer to the working memory
+ * @param       pGraph      Pointer to the graph
+ * @param       v           Vertex
+ *
+ * @return      Index of the bucket
+ */
+static size_t bucket_of(const greedy_t* pGreedy, const graph_t* pGraph, vertex_t v)
+{
+    if (0U == pGreedy->pOutDeg[v])
+    {
+        return BUCKET_SINK;
+    }
+
+    if (0U == pGreedy->pInDeg[v])
+    {
+        return BUCKET_SOURCE;
+    }
+
+    return BUCKET_FIRST + pGraph->maxDeg + pGreedy->pOutDeg[v] - pGreedy->pInDeg[v];
+}
+
+/**
+ * @brief       Bucket Insert
+ * @details     This internal method is used to put a vertex into its bucket.
+ *              It is put at the front or the back by chance, so that ties get broken randomly.
+ *
+ * @param       pGreedy     Pointer to the working memory
+ * @param       pGraph      Pointer to the graph
+ * @param       pRng        Pointer to the random number generator
+ * @param       v           Vertex
+ */
+static void bucket_insert(greedy_t* pGreedy, const graph_t* pGraph, prng_t* pRng, vertex_t v)
+{
+    size_t b = bucket_of(pGreedy, pGraph, v);
+
+    pGreedy->pBucket[v] = b;
+
+    if (-1 == pGreedy->pHead[b])
+    {
+        pGreedy->pHead[b] = v;
+        pGreedy->pTail[b] = v;
+        pGreedy->pNext[v] = -1;
+        pGreedy->pPrev[v] = -1;
+    }
+    else if (prng_next(pRng) & 1U)
+    {
+        pGreedy->pNext[v] = pGreedy->pHead[b];
+        pGreedy->pPrev[v] = -1;
+        pGreedy->pPrev[pGreedy->pHead[b]] = v;
+        pGreedy->pHead[b] = v;
+    }
+    else
+    {
+        pGreedy->pPrev[v] = pGreedy->pTail[b];
+        pGreedy->pNext[v] = -1;
+        pGreedy->pNext[pGreedy->pTail[b]] = v;
+        pGreedy->pTail[b] = v;
+    }
+
+    if ((b >= BUCKET_FIRST) && (b > pGreedy->maxBucket))
+    {
+        pGreedy->maxBucket = b;
+    }
+}
+
+/**
+ * @brief       Bucket Remove
+ * @details     This internal method is used to take a vertex out of its bucket.
+ *
+ * @param       pGreedy     Pointer to the working memory
+ * @param       v           Vertex
+ */
+static void bucket_remove(greedy_t* pGreedy, vertex_t v)
+{
+    size_t b = pGreedy->pBucket[v];
+
+    if (-1 != pGreedy->pPrev[v])
+    {
+        pGreedy->pNext[pGreedy->pPrev[v]] = pGreedy->pNext[v];
+    }
+    else
+    {
+        pGreedy->pHead[b] = pGreedy->pNext[v];
+    }
+
+    if (-1 != pGreedy->pNext[v])
+    {
+        pGreedy->pPrev[pGreedy->pNext[v]] = pGreedy->pPrev[v];
+    }
+    else
+    {
+        pGreedy->pTail[b] = pGreedy->pPrev[v];
+    }
+}
+
+/**
+ * @brief       Place Vertex
+ * @details     This internal method is used to remove a vertex from the remaining graph.
+ *              The degrees of its neighbours change, so they are moved to their new buckets.
+ *
+ * @param       pGreedy     Pointer to the working memory
+ * @param       pGraph      Pointer to the graph
+ * @param       pRng        Pointer to the random number generator
+ * @param       v           Vertex
+ */
+static void place_vertex(greedy_t* pGreedy, const graph_t* pGraph, prng_t* pRng, vertex_t v)
+{
+    bucket_remove(pGreedy, v);
+    pGreedy->pPlaced[v] = true;
+
+    for (uint32_t i = pGraph->pOutOff[v]; i < pGraph->pOutOff[v + 1U]; i++)
+    {
+        vertex_t w = pGraph->pOut[i];
+
+        if (!pGreedy->pPlaced[w])
+        {
+            bucket_remove(pGreedy, w);
+            pGreedy->pInDeg[w]--;
+            bucket_insert(pGreedy, pGraph, pRng, w);
+        }
+    }
+
+    for (uint32_t i = pGraph->pInOff[v]; i < pGraph->pInOff[v + 1U]; i++)
+    {
+        vertex_t w = pGraph->pIn[i];
+
+        if (!pGreedy->pPlaced[w])
+        {
+            bucket_remove(pGreedy, w);
+            pGreedy->pOutDeg[w]--;
+            bucket_insert(pGreedy, pGraph, pRng, w);
+        }
+    }
+}
+
+/**
+ * @brief       Greedy Init
+ * @details     This method is used to allocate the working memory of the greedy order.
+ *
+ * @param       pGreedy     Pointer to the working memory
+ * @param       pGraph      Pointer to the graph
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ */
+error_t greedy_init(greedy_t* pGreedy, const graph_t* pGraph)
+{
+    memset(pGreedy, 0, sizeof(greedy_t));
+    pGreedy->bucketCnt = (2U * pGraph->maxDeg) + BUCKET_FIRST + 1U;
+    pGreedy->pHead = malloc(sizeof(int32_t) * pGreedy->bucketCnt);
+    pGreedy->pTail = malloc(sizeof(int32_t) * pGreedy->bucketCnt);
+    pGreedy->pNext = malloc(sizeof(int32_t) * pGraph->idCnt);
+    pGreedy->pPrev = malloc(sizeof(int32_t) * pGraph->idCnt);
+    pGreedy->pBucket = malloc(sizeof(size_t) * pGraph->idCnt);
+    pGreedy->pOutDeg = malloc(sizeof(uint32_t) * pGraph->idCnt);
+    pGreedy->pInDeg = malloc(sizeof(uint32_t) * pGraph->idCnt);
+    pGreedy->pPlaced = malloc(sizeof(bool) * pGraph->idCnt);
+
+    if ((NULL == pGreedy->pHead) || (NULL == pGreedy->pTail) || (NULL == pGreedy->pNext) ||
+        (NULL == pGreedy->pPrev) || (NULL == pGreedy->pBucket) || (NULL == pGreedy->pOutDeg) ||
+        (NULL == pGreedy->pInDeg) || (NULL == pGreedy->pPlaced))
+    {
+        greedy_free(pGreedy);
+        return ERROR_NULLPTR;
+    }
+
+    return ERROR_OK;
+}
+
+/**
+ * @brief       Greedy Free
+ * @details     This method is used to free the working memory of the greedy order.
+ *
+ * @param       pGreedy     Pointer to the working memory
+ */
+void greedy_free(greedy_t* pGreedy)
+{
+    free(pGreedy->pHead);
+    free(pGreedy->pTail);
+    free(pGreedy->pNext);
+    free(pGreedy->pPrev);
+    free(pGreedy->pBucket);
+    free(pGreedy->pOutDeg);
+    free(pGreedy->pInDeg);
+    free(pGreedy->pPlaced);
+    memset(pGreedy, 0, sizeof(greedy_t));
+}
+
+/**
+ * @brief       Greedy Order
+ * @details     This method is used to build an order of the vertices with the heuristic of Eades, Lin and Smyth.
+ *              Sinks are placed at the end and sources at the front of the order. If there is neither, the vertex with
+ *              the biggest out-degree minus in-degree is placed at the front. Every placed vertex is removed from
+ *              the graph, so its neighbours may become sinks or sources. With the bucket queues this is O(V + E).
+ *              Ties are broken by the current order of the vertices and by chance, so every call can give a
+ *              different order.
+ *
+ * @param       pGreedy     Pointer to the working memory
+ * @param       pGraph      Pointer to the graph
+ * @param       pRng        Pointer to the random number generator
+ * @param       pVert       Pointer to the vertices (read), gets replaced by the order (write)
+ * @param       vertCnt     Number of vertices
+ * @param       pPos        Pointer to the positions, indexed by the vertex id (write)
+ */
+void greedy_order(greedy_t* pGreedy, const graph_t* pGraph, prng_t* pRng, vertex_t* pVert, size_t vertCnt,
+                  vertex_t* pPos)
+{
+    size_t front = 0U;
+    size_t back = vertCnt;
+
+    for (size_t b = 0U; b < pGreedy->bucketCnt; b++)
+    {
+        pGreedy->pHead[b] = -1;
+        pGreedy->pTail[b] = -1;
+    }
+
+    pGreedy->maxBucket = BUCKET_FIRST;
+
+    // fill the buckets with the full degrees
+    for (size_t i = 0U; i < vertCnt; i++)
+    {
+        vertex_t v = pVert[i];
+
+        pGreedy->pOutDeg[v] = pGraph->pOutOff[v + 1U] - pGraph->pOutOff[v];
+        pGreedy->pInDeg[v] = pGraph->pInOff[v + 1U] - pGraph->pInOff[v];
+        pGreedy->pPlaced[v] = false;
+        bucket_insert(pGreedy, pGraph, pRng, v);
+    }
+
+    while (front < back)
+    {
+        int32_t v = -1;
+
+        if (-1 != pGreedy->pHead[BUCKET_SINK])
+        {
+            // sinks go to the end
+            v = pGreedy->pHead[BUCKET_SINK];
+            back--;
+            pVert[back] = (vertex_t)v;
+            pPos[v] = (vertex_t)back;
+        }
+        else
+        {
+            if (-1 != pGreedy->pHead[BUCKET_SOURCE])
+            {
+                v = pGreedy->pHead[BUCKET_SOURCE];
+            }
+            else
+            {
+                // biggest out-degree minus in-degree
+                while (-1 == pGreedy->pHead[pGreedy->maxBucket])
+                {
+                    pGreedy->maxBucket--;
+                }
+                v = pGreedy->pHead[pGreedy->maxBucket];
+            }
+
+            pVert[front] = (vertex_t)v;
+            pPos[v] = (vertex_t)front;
+            front++;
+        }
+
+        place_vertex(pGreedy, pGraph, pRng, (vertex_t)v);
+    }
+}
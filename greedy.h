@@ -0,0 +1,43 @@
+#pragma once
+
+/**
+ * @file  greedy.h
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ * @brief Greedy vertex order (Eades, Lin, Smyth)
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "errors.h"
+#include "graph.h"
+#include "prng.h"
+
+/*!
+ * @struct greedy_t
+ * @brief  Working memory of the greedy order (bucket queues)
+ *
+ * @details Every vertex which is not yet placed is in exactly one bucket: the sinks, the sources, or the bucket of its
+ *          out-degree minus in-degree. The buckets are doubly linked lists over the vertex ids.
+ **/
+typedef struct
+{
+    size_t bucketCnt;  /*!< number of buckets, 2 * maxDeg + 3 */
+    size_t maxBucket;  /*!< no bucket above this one has a vertex */
+    int32_t* pHead;    /*!< first vertex of each bucket, -1 if empty */
+    int32_t* pTail;    /*!< last vertex of each bucket, -1 if empty */
+    int32_t* pNext;    /*!< next vertex in the bucket, indexed by the vertex id */
+    int32_t* pPrev;    /*!< previous vertex in the bucket, indexed by the vertex id */
+    size_t* pBucket;   /*!< bucket of the vertex, indexed by the vertex id */
+    uint32_t* pOutDeg; /*!< out-degree in the remaining graph, indexed by the vertex id */
+    uint32_t* pInDeg;  /*!< in-degree in the remaining graph, indexed by the vertex id */
+    bool* pPlaced;     /*!< vertex is already part of the order, indexed by the vertex id */
+} greedy_t;
+
+/* **** FUNCTIONS **** */
+error_t greedy_init(greedy_t* pGreedy, const graph_t* pGraph);
+void greedy_free(greedy_t* pGreedy);
+void greedy_order(greedy_t* pGreedy, const graph_t* pGraph, prng_t* pRng, vertex_t* pVert, size_t vertCnt,
+                  vertex_t* pPos);
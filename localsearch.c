@@ -0,0 +1,227 @@
+#include "localsearch.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+/**
+ * @file localsearch.c
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ */
+
+/**
+ * @brief       Compare Events
+ * @details     This internal method is used to sort the events by the position of the neighbour (qsort).
+ *
+ * @param       pA      Pointer to the first event
+ * @param       pB      Pointer to the second event
+ *
+ * @return      <0, 0 or >0 like strcmp
+ */
+static int compare_events(const void* pA, const void* pB)
+{
+    const ls_event_t* pEvA = pA;
+    const ls_event_t* pEvB = pB;
+
+    return (pEvA->pos > pEvB->pos) - (pEvA->pos < pEvB->pos);
+}
+
+/**
+ * @brief       Move Vertex
+ * @details     This internal method is used to move a vertex to a new position.
+ *              All vertices in between get shifted by one and their positions get updated.
+ *
+ * @param       pVert   Pointer to the order of the vertices (read and write)
+ * @param       pPos    Pointer to the positions, indexed by the vertex id (read and write)
+ * @param       from    Current position of the vertex
+ * @param       to      New position of the vertex
+ */
+static void move_vertex(vertex_t* pVert, vertex_t* pPos, size_t from, size_t to)
+{
+    vertex_t v = pVert[from];
+
+    if (from < to)
+    {
+        for (size_t i = from; i < to; i++)
+        {
+            pVert[i] = pVert[i + 1U];
+            pPos[pVert[i]] = (vertex_t)i;
+        }
+    }
+    else
+    {
+        for (size_t i = from; i > to; i--)
+        {
+            pVert[i] = pVert[i - 1U];
+            pPos[pVert[i]] = (vertex_t)i;
+        }
+    }
+
+    pVert[to] = v;
+    pPos[v] = (vertex_t)to;
+}
+
+/**
+ * @brief       Sift Vertex
+ * @details     This internal method is used to find the best position for one vertex, all other vertices keep
+ *              their relative order (insertion move, an adjacent swap is the special case of moving by one).
+ *              Moving the vertex over a neighbour only changes the edges between these two, so the change of the
+ *              number of back edges is summed up over the neighbours sorted by their position. The vertex is only
+ *              moved if this strictly reduces the number of back edges.
+ *
+ * @param       pLs     Pointer to the working memory
+ * @param       pGraph  Pointer to the graph
+ * @param       pVert   Pointer to the order of the vertices (read and write)
+ * @param       pPos    Pointer to the positions, indexed by the vertex id (read and write)
+ * @param       v       Vertex which should be moved
+ *
+ * @return      Number of back edges which were removed
+ */
+static size_t sift_vertex(localsearch_t* pLs, const graph_t* pGraph, vertex_t* pVert, vertex_t* pPos, vertex_t v)
+{
+    size_t evCnt = 0U;
+    size_t from = pPos[v];
+    size_t to = from;
+    int32_t bestDelta = 0;
+    int32_t delta = 0;
+
+    // moving v over a successor to the right turns the edge into a back edge, over a predecessor it gets a forward edge
+    for (uint32_t i = pGraph->pOutOff[v]; i < pGraph->pOutOff[v + 1U]; i++)
+    {
+        pLs->pEvents[evCnt].pos = pPos[pGraph->pOut[i]];
+        pLs->pEvents[evCnt].weight = 1;
+        evCnt++;
+    }
+
+    for (uint32_t i = pGraph->pInOff[v]; i < pGraph->pInOff[v + 1U]; i++)
+    {
+        pLs->pEvents[evCnt].pos = pPos[pGraph->pIn[i]];
+        pLs->pEvents[evCnt].weight = -1;
+        evCnt++;
+    }
+
+    qsort(pLs->pEvents, evCnt, sizeof(ls_event_t), compare_events);
+
+    // moves to the right, the vertex is placed behind the neighbour
+    delta = 0;
+    for (size_t i = 0U; i < evCnt; i++)
+    {
+        if (pLs->pEvents[i].pos <= from)
+        {
+            continue;
+        }
+
+        delta += pLs->pEvents[i].weight;
+
+        // only a complete neighbour (all parallel edges) can be passed
+        if (((i + 1U) == evCnt) || (pLs->pEvents[i + 1U].pos != pLs->pEvents[i].pos))
+        {
+            if (delta < bestDelta)
+            {
+                bestDelta = delta;
+                to = pLs->pEvents[i].pos;
+            }
+        }
+    }
+
+    // moves to the left, the vertex is placed in front of the neighbour
+    delta = 0;
+    for (size_t i = evCnt; i > 0U; i--)
+    {
+        if (pLs->pEvents[i - 1U].pos >= from)
+        {
+            continue;
+        }
+
+        delta -= pLs->pEvents[i - 1U].weight;
+
+        if ((1U == i) || (pLs->pEvents[i - 2U].pos != pLs->pEvents[i - 1U].pos))
+        {
+            if (delta < bestDelta)
+            {
+                bestDelta = delta;
+                to = pLs->pEvents[i - 1U].pos;
+            }
+        }
+    }
+
+    if (bestDelta < 0)
+    {
+        move_vertex(pVert, pPos, from, to);
+    }
+
+    return (size_t)(-bestDelta);
+}
+
+/**
+ * @brief       Local Search Init
+ * @details     This method is used to allocate the working memory of the local search.
+ *
+ * @param       pLs     Pointer to the working memory
+ * @param       pGraph  Pointer to the graph
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ */
+error_t localsearch_init(localsearch_t* pLs, const graph_t* pGraph)
+{
+    pLs->pEvents = malloc(sizeof(ls_event_t) * (pGraph->maxDeg + 1U));
+
+    return (NULL == pLs->pEvents) ? ERROR_NULLPTR : ERROR_OK;
+}
+
+/**
+ * @brief       Local Search Free
+ * @details     This method is used to free the working memory of the local search.
+ *
+ * @param       pLs     Pointer to the working memory
+ */
+void localsearch_free(localsearch_t* pLs)
+{
+    free(pLs->pEvents);
+    pLs->pEvents = NULL;
+}
+
+/**
+ * @brief       Local Search Improve
+ * @details     This method is used to improve an order of the vertices.
+ *              Every vertex gets moved to its best position (sifting), until a whole pass brings no improvement or
+ *              LOCALSEARCH_MAX_PASSES is reached. The number of back edges never increases.
+ *
+ * @param       pLs     Pointer to the working memory
+ * @param       pGraph  Pointer to the graph
+ * @param       pVert   Pointer to the order of the vertices (read and write)
+ * @param       pPos    Pointer to the positions, indexed by the vertex id (read and write)
+ *
+ * @return      Number of back edges which were removed
+ */
+size_t localsearch_improve(localsearch_t* pLs, const graph_t* pGraph, vertex_t* pVert, vertex_t* pPos)
+{
+    size_t total = 0U;
+
+    for (size_t pass = 0U; pass < LOCALSEARCH_MAX_PASSES; pass++)
+    {
+        size_t gain = 0U;
+
+        for (size_t v = 0U; v < pGraph->idCnt; v++)
+        {
+            // only vertices which are part of the order
+            if ((pGraph->pOutOff[v] == pGraph->pOutOff[v + 1U]) && (pGraph->pInOff[v] == pGraph->pInOff[v + 1U]))
+            {
+                continue;
+            }
+
+            gain += sift_vertex(pLs, pGraph, pVert, pPos, (vertex_t)v);
+        }
+
+        total += gain;
+
+        if (0U == gain)
+        {
+            break;
+        }
+    }
+
+    return total;
+}
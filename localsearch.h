@@ -0,0 +1,40 @@
+#pragma once
+
+/**
+ * @file  localsearch.h
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ * @brief Improvement of a vertex order by moving single vertices
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "errors.h"
+#include "graph.h"
+
+#define LOCALSEARCH_MAX_PASSES 16U /*!< Maximum number of passes over all vertices */
+
+/*!
+ * @struct ls_event_t
+ * @brief  Neighbour of the vertex which gets moved
+ **/
+typedef struct
+{
+    uint32_t pos;   /*!< position of the neighbour */
+    int32_t weight; /*!< change of the back edges if the vertex is moved to the right over the neighbour */
+} ls_event_t;
+
+/*!
+ * @struct localsearch_t
+ * @brief  Working memory of the local search
+ **/
+typedef struct
+{
+    ls_event_t* pEvents; /*!< neighbours of the current vertex, maxDeg elements */
+} localsearch_t;
+
+/* **** FUNCTIONS **** */
+error_t localsearch_init(localsearch_t* pLs, const graph_t* pGraph);
+void localsearch_free(localsearch_t* pLs);
+size_t localsearch_improve(localsearch_t* pLs, const graph_t* pGraph, vertex_t* pVert, vertex_t* pPos);
@@ -0,0 +1,351 @@
+#include "lowerbound.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file lowerbound.c
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ */
+
+/*!
+ * @struct packing_t
+ * @brief  Working memory of the cycle packing
+ **/
+typedef struct
+{
+    uint8_t* pUsed;        /*!< edge is part of a packed cycle, indexed like the successors of the graph */
+    uint32_t* pStamp;      /*!< stamp of the search which reached the vertex */
+    uint32_t* pParentEdge; /*!< edge over which the vertex was reached (index of the successors) */
+    vertex_t* pParent;     /*!< vertex from which the vertex was reached */
+    vertex_t* pQueue;      /*!< queue of the breadth-first search */
+    vertex_t* pOrder;      /*!< order in which the vertices of the component start a search */
+    uint32_t stamp;        /*!< stamp of the current search */
+    size_t* pPatience;     /*!< packings of every component in a row without a better bound */
+} packing_t;
+
+/**
+ * @brief       Packing Free
+ * @details     This internal method is used to free the working memory of the cycle packing.
+ *
+ * @param       pWork       Pointer to the working memory
+ */
+static void packing_free(packing_t* pWork)
+{
+    free(pWork->pUsed);
+    free(pWork->pStamp);
+    free(pWork->pParentEdge);
+    free(pWork->pParent);
+    free(pWork->pQueue);
+    free(pWork->pOrder);
+    free(pWork->pPatience);
+    memset(pWork, 0, sizeof(packing_t));
+}
+
+/**
+ * @brief       Packing Alloc
+ * @details     This internal method is used to allocate the working memory for the whole graph.
+ *
+ * @param       pWork       Pointer to the working memory (write)
+ * @param       pLb         Pointer to the engine
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ */
+static error_t packing_alloc(packing_t* pWork, const lowerbound_t* pLb)
+{
+    size_t idCnt = pLb->pGraph->idCnt;
+
+    memset(pWork, 0, sizeof(packing_t));
+    pWork->pUsed = calloc(sizeof(uint8_t), pLb->pGraph->edgeCnt + 1U);
+    pWork->pStamp = calloc(sizeof(uint32_t), idCnt);
+    pWork->pParentEdge = malloc(sizeof(uint32_t) * idCnt);
+    pWork->pParent = malloc(sizeof(vertex_t) * idCnt);
+    pWork->pQueue = malloc(sizeof(vertex_t) * idCnt);
+    pWork->pOrder = malloc(sizeof(vertex_t) * idCnt);
+    pWork->pPatience = calloc(sizeof(size_t), pLb->scc.compCnt);
+
+    if ((NULL == pWork->pUsed) || (NULL == pWork->pStamp) || (NULL == pWork->pParentEdge) ||
+        (NULL == pWork->pParent) || (NULL == pWork->pQueue) || (NULL == pWork->pOrder) || (NULL == pWork->pPatience))
+    {
+        packing_free(pWork);
+        return ERROR_NULLPTR;
+    }
+
+    return ERROR_OK;
+}
+
+/**
+ * @brief       Find Cycle
+ * @details     This internal method is used to find a shortest cycle through a vertex which uses no packed edge.
+ *              A breadth-first search from the vertex stays in its component, the first edge back to the vertex
+ *              closes the cycle. Its edges are marked as packed then.
+ *
+ * @param       pLb         Pointer to the engine
+ * @param       pWork       Pointer to the working memory
+ * @param       start       Vertex the cycle goes through
+ * @param       comp        Component of the vertex
+ *
+ * @return      true if a cycle was found and packed
+ */
+static bool find_cycle(const lowerbound_t* pLb, packing_t* pWork, vertex_t start, uint32_t comp)
+{
+    const graph_t* pGraph = pLb->pGraph;
+    size_t head = 0U;
+    size_t tail = 0U;
+
+    pWork->stamp++;
+
+    if (0U == pWork->stamp)
+    {
+        // the stamps wrapped around, every old stamp has to be forgotten
+        memset(pWork->pStamp, 0, sizeof(uint32_t) * pGraph->idCnt);
+        pWork->stamp = 1U;
+    }
+
+    pWork->pStamp[start] = pWork->stamp;
+    pWork->pQueue[tail++] = start;
+
+    while (head < tail)
+    {
+        vertex_t u = pWork->pQueue[head++];
+
+        for (uint32_t j = pGraph->pOutOff[u]; j < pGraph->pOutOff[u + 1U]; j++)
+        {
+            vertex_t w = pGraph->pOut[j];
+
+            if ((0U != pWork->pUsed[j]) || (comp != pLb->scc.pComp[w]))
+            {
+                continue;
+            }
+
+            if (start == w)
+            {
+                // the edge back closes the cycle, the rest of it is the path of the search
+                pWork->pUsed[j] = 1U;
+
+                for (vertex_t x = u; start != x; x = pWork->pParent[x])
+                {
+                    pWork->pUsed[pWork->pParentEdge[x]] = 1U;
+                }
+
+                return true;
+            }
+
+            if (pWork->stamp != pWork->pStamp[w])
+            {
+                pWork->pStamp[w] = pWork->stamp;
+                pWork->pParentEdge[w] = j;
+                pWork->pParent[w] = u;
+                pWork->pQueue[tail++] = w;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief       Pack Component
+ * @details     This internal method is used to pack edge-disjoint cycles into a component greedily.
+ *              The vertices are visited in a random order, each one packs shortest cycles through itself until there
+ *              is none left. Edges only get packed, so a vertex without a cycle never gets one again and the packing
+ *              is maximal in the end. Short cycles use up few edges, which leaves more for the others.
+ *
+ * @param       pLb         Pointer to the engine
+ * @param       pWork       Pointer to the working memory
+ * @param       comp        Number of the component
+ *
+ * @return      Number of packed cycles (only a part of them if the engine was stopped)
+ */
+static size_t pack_component(lowerbound_t* pLb, packing_t* pWork, uint32_t comp)
+{
+    const graph_t* pGraph = pLb->pGraph;
+    uint32_t first = pLb->scc.pOff[comp];
+    uint32_t cnt = pLb->scc.pOff[comp + 1U] - first;
+    size_t cycles = 0U;
+
+    for (uint32_t i = 0U; i < cnt; i++)
+    {
+        vertex_t v = pLb->scc.pVert[first + i];
+
+        memset(&pWork->pUsed[pGraph->pOutOff[v]], 0, pGraph->pOutOff[v + 1U] - pGraph->pOutOff[v]);
+        pWork->pOrder[i] = v;
+    }
+
+    for (uint32_t i = cnt; 1U < i; i--)
+    {
+        uint32_t j = prng_bounded(&pLb->rng, i);
+        vertex_t tmp = pWork->pOrder[i - 1U];
+
+        pWork->pOrder[i - 1U] = pWork->pOrder[j];
+        pWork->pOrder[j] = tmp;
+    }
+
+    for (uint32_t i = 0U; (i < cnt) && (false == __atomic_load_n(&pLb->stop, __ATOMIC_RELAXED)); i++)
+    {
+        while (find_cycle(pLb, pWork, pWork->pOrder[i], comp))
+        {
+            cycles++;
+        }
+    }
+
+    return cycles;
+}
+
+/**
+ * @brief       Lower Bound Main
+ * @details     This internal method is the loop of the engine. It packs every component again and again and
+ *              publishes a better bound right away. A component is skipped once it is solved, or after
+ *              LOWERBOUND_PATIENCE packings in a row did not improve its bound. The thread ends if no component is
+ *              left or it gets stopped.
+ *
+ * @param       pArg        Pointer to the engine
+ *
+ * @return      NULL
+ */
+static void* lowerbound_main(void* pArg)
+{
+    lowerbound_t* pLb = pArg;
+    packing_t work;
+    bool busy = true;
+
+    if (ERROR_OK != packing_alloc(&work, pLb))
+    {
+        return NULL;
+    }
+
+    while (busy && (false == __atomic_load_n(&pLb->stop, __ATOMIC_RELAXED)))
+    {
+        busy = false;
+
+        for (uint32_t c = 0U; (c < pLb->scc.compCnt) && (false == __atomic_load_n(&pLb->stop, __ATOMIC_RELAXED)); c++)
+        {
+            size_t cycles = 0U;
+
+            if ((LOWERBOUND_PATIENCE <= work.pPatience[c]) ||
+                ((SHAREDMEM_COMP_CNT > c) && (NULL != pLb->pSolved) &&
+                 __atomic_load_n(&pLb->pSolved[c], __ATOMIC_RELAXED)))
+            {
+                continue;
+            }
+
+            busy = true;
+            cycles = pack_component(pLb, &work, c);
+
+            // a packing which was cut short is still a packing, its bound holds as well
+            if (cycles > __atomic_load_n(&pLb->pBounds[c], __ATOMIC_RELAXED))
+            {
+                __atomic_store_n(&pLb->pBounds[c], cycles, __ATOMIC_RELAXED);
+                __atomic_fetch_add(&pLb->version, 1U, __ATOMIC_RELEASE);
+                work.pPatience[c] = 0U;
+            }
+            else
+            {
+                work.pPatience[c]++;
+            }
+        }
+    }
+
+    packing_free(&work);
+
+    return NULL;
+}
+
+/**
+ * @brief       Lower Bound Start
+ * @details     This method is used to decompose the graph and start the thread of the engine.
+ *              Without a cyclic component no thread is started, every bound is 0 then.
+ *
+ * @param       pLb         Pointer to the engine (write)
+ * @param       pGraph      Pointer to the adjacency of the graph (dense ids), it has to stay valid until the stop
+ * @param       pSolved     Pointer to the solved flags of the components (SHAREDMEM_COMP_CNT elements), or NULL
+ * @param       seed        Seed of the random orders
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ * @retval      ERROR_PARAM     The thread could not be started
+ */
+error_t lowerbound_start(lowerbound_t* pLb, const graph_t* pGraph, const bool* pSolved, uint64_t seed)
+{
+    error_t retCode = ERROR_OK;
+
+    memset(pLb, 0, sizeof(lowerbound_t));
+    pLb->pGraph = pGraph;
+    pLb->pSolved = pSolved;
+    prng_init(&pLb->rng, seed, 0U);
+
+    retCode |= scc_find(pGraph, &pLb->scc);
+
+    if ((ERROR_OK != retCode) || (0U == pLb->scc.compCnt))
+    {
+        return retCode;
+    }
+
+    pLb->pBounds = calloc(sizeof(size_t), pLb->scc.compCnt);
+
+    if (NULL == pLb->pBounds)
+    {
+        return ERROR_NULLPTR;
+    }
+
+    pLb->started = (0 == pthread_create(&pLb->thread, NULL, lowerbound_main, pLb));
+
+    return pLb->started ? ERROR_OK : ERROR_PARAM;
+}
+
+/**
+ * @brief       Lower Bound Get
+ * @details     This method is used to read the best lower bound of a component so far.
+ *
+ * @param       pLb         Pointer to the engine
+ * @param       comp        Number of the component
+ *
+ * @return      Lower bound of the minimum solution of the component, 0 if none is known
+ */
+size_t lowerbound_get(const lowerbound_t* pLb, size_t comp)
+{
+    if ((NULL == pLb->pBounds) || (comp >= pLb->scc.compCnt))
+    {
+        return 0U;
+    }
+
+    return __atomic_load_n(&pLb->pBounds[comp], __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief       Lower Bound Version
+ * @details     This method is used to check cheaply if any bound got better since the last look.
+ *
+ * @param       pLb         Pointer to the engine
+ *
+ * @return      Number of improvements so far
+ */
+uint64_t lowerbound_version(const lowerbound_t* pLb)
+{
+    return __atomic_load_n(&pLb->version, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief       Lower Bound Stop
+ * @details     This method is used to stop the thread of the engine and free everything. It may be called on an
+ *              engine which was never started (zeroed).
+ *
+ * @param       pLb         Pointer to the engine
+ */
+void lowerbound_stop(lowerbound_t* pLb)
+{
+    __atomic_store_n(&pLb->stop, true, __ATOMIC_RELAXED);
+
+    if (pLb->started)
+    {
+        pthread_join(pLb->thread, NULL);
+    }
+
+    free(pLb->pBounds);
+    scc_free(&pLb->scc);
+    memset(pLb, 0, sizeof(lowerbound_t));
+}
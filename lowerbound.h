@@ -0,0 +1,49 @@
+#pragma once
+
+/**
+ * @file  lowerbound.h
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ * @brief Lower bounds of the cyclic components by edge-disjoint cycle packing (background thread of the supervisor)
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common.h"
+#include "errors.h"
+#include "graph.h"
+#include "prng.h"
+#include "scc.h"
+
+#define LOWERBOUND_PATIENCE 64U /*!< Packings of a component in a row without a better bound before it is given up */
+
+/*!
+ * @struct lowerbound_t
+ * @brief  Lower bound engine
+ *
+ * @details Every feedback arc set has to remove at least one edge of every cycle, so the number of edge-disjoint
+ *          cycles in a component is a lower bound of its minimum. The engine packs cycles greedily, again and again
+ *          in another random order, and keeps the best packing of every component. The components are numbered
+ *          like the ones of the generators, since they decompose the same graph.
+ **/
+typedef struct
+{
+    const graph_t* pGraph; /*!< adjacency of the whole graph (dense ids), owned by the caller */
+    scc_t scc;             /*!< cyclic components of the graph */
+    size_t* pBounds;       /*!< best lower bound of every component (atomic) */
+    uint64_t version;      /*!< increased with every better bound (atomic) */
+    const bool* pSolved;   /*!< solved flag of the first SHAREDMEM_COMP_CNT components, they are skipped (atomic) */
+    bool stop;             /*!< the thread should stop (atomic) */
+    bool started;          /*!< the thread was started and has to be joined */
+    pthread_t thread;      /*!< thread of the engine */
+    prng_t rng;            /*!< random order of the packings */
+} lowerbound_t;
+
+/* **** FUNCTIONS **** */
+error_t lowerbound_start(lowerbound_t* pLb, const graph_t* pGraph, const bool* pSolved, uint64_t seed);
+size_t lowerbound_get(const lowerbound_t* pLb, size_t comp);
+uint64_t lowerbound_version(const lowerbound_t* pLb);
+void lowerbound_stop(lowerbound_t* pLb);
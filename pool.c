@@ -0,0 +1,320 @@
+#define _GNU_SOURCE /* sched_setaffinity and the CPU_* macros */
+
+#include "pool.h"
+
+#include <sched.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "debug.h"
+
+/**
+ * @file pool.c
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ */
+
+#define POOL_GENERATOR "generator" /*!< Name of the generator binary, next to the supervisor */
+
+/**
+ * @brief       Generator Path
+ * @details     This internal method is used to get the path of the generator binary. It is expected in the same
+ *              directory as the supervisor, if the supervisor was started without a directory it is searched in
+ *              the PATH.
+ *
+ * @param       pSelf   Path of the supervisor (argv[0])
+ *
+ * @return      Path of the generator (allocated), NULL if the memory could not be allocated
+ */
+static char* generator_path(const char* pSelf)
+{
+    const char* pSlash = strrchr(pSelf, '/');
+    size_t dirLen = (NULL == pSlash) ? 0U : (size_t)(pSlash - pSelf) + 1U;
+    char* pPath = malloc(dirLen + sizeof(POOL_GENERATOR));
+
+    if (NULL != pPath)
+    {
+        memcpy(pPath, pSelf, dirLen);
+        memcpy(pPath + dirLen, POOL_GENERATOR, sizeof(POOL_GENERATOR));
+    }
+
+    return pPath;
+}
+
+/**
+ * @brief       Assign CPUs
+ * @details     This internal method is used to choose the CPU of every generator.
+ *              The CPUs which the supervisor may use are taken round-robin, without the CPU of the consumer if
+ *              there is at least one other. If the affinity cannot be read, the generators are not pinned.
+ *
+ * @param       pPool           Pointer to the pool
+ * @param       consumerCpu     CPU of the consumer or POOL_NO_CPU
+ */
+static void assign_cpus(pool_t* pPool, int consumerCpu)
+{
+    cpu_set_t allowed;
+    int cpus[CPU_SETSIZE];
+    size_t cpuCnt = 0U;
+
+    CPU_ZERO(&allowed);
+
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) < 0)
+    {
+        for (size_t i = 0U; i < pPool->cnt; i++)
+        {
+            pPool->pCpus[i] = POOL_NO_CPU;
+        }
+        return;
+    }
+
+    // the consumer only gets its own core if the generators keep at least one
+    if ((POOL_NO_CPU != consumerCpu) && (CPU_COUNT(&allowed) > 1) && CPU_ISSET(consumerCpu, &allowed))
+    {
+        CPU_CLR(consumerCpu, &allowed);
+    }
+
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    {
+        if (CPU_ISSET(cpu, &allowed))
+        {
+            cpus[cpuCnt++] = cpu;
+        }
+    }
+
+    for (size_t i = 0U; i < pPool->cnt; i++)
+    {
+        pPool->pCpus[i] = cpus[i % cpuCnt];
+    }
+}
+
+/**
+ * @brief       Spawn
+ * @details     This internal method is used to start one generator. The child pins itself to the CPU of the
+ *              generator before the binary is executed, the affinity is kept by exec.
+ *
+ * @param       pPool   Pointer to the pool
+ * @param       idx     Index of the generator
+ *
+ * @return      Error code
+ * @retval      ERROR_OK            Everything went fine
+ * @retval      ERROR_FORK_FAILED   The process could not be created
+ */
+static error_t spawn(pool_t* pPool, size_t idx)
+{
+    pid_t pid = fork();
+
+    if (pid < 0)
+    {
+        debug("Fork failed\n", NULL);
+        pPool->pPids[idx] = 0;
+        return ERROR_FORK_FAILED;
+    }
+
+    if (0 == pid)
+    {
+        if (POOL_NO_CPU != pPool->pCpus[idx])
+        {
+            pool_pin(pPool->pCpus[idx]);
+        }
+
+        if (NULL == strchr(pPool->pArgv[0], '/'))
+        {
+            execvp(pPool->pArgv[0], pPool->pArgv);
+        }
+        else
+        {
+            execv(pPool->pArgv[0], pPool->pArgv);
+        }
+
+        // only reached if the binary could not be executed
+        _exit(EXIT_FAILURE);
+    }
+
+    pPool->pPids[idx] = pid;
+    debug("Generator %zu started with pid %d on cpu %d\n", idx, pid, pPool->pCpus[idx]);
+
+    return ERROR_OK;
+}
+
+/**
+ * @brief       Pool Pin
+ * @details     This method is used to pin the calling process (or thread) to one CPU.
+ *
+ * @param       cpu     Number of the CPU
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_PARAM     The CPU does not exist or may not be used
+ */
+error_t pool_pin(int cpu)
+{
+    cpu_set_t set;
+
+    if ((cpu < 0) || (cpu >= CPU_SETSIZE))
+    {
+        return ERROR_PARAM;
+    }
+
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    return (sched_setaffinity(0, sizeof(set), &set) < 0) ? ERROR_PARAM : ERROR_OK;
+}
+
+/**
+ * @brief       Pool Start
+ * @details     This method is used to start the generators. They get no edges, so they take the graph which the
+ *              supervisor put into the shared memory.
+ *
+ * @param       pPool           Pointer to the pool (write)
+ * @param       pSelf           Path of the supervisor (argv[0]), the generator is expected next to it
+ * @param       cnt             Number of generators
+ * @param       ppOpts          Options of the generators, NULL terminated (at most POOL_MAX_ARGS)
+ * @param       consumerCpu     CPU of the consumer, which the generators should not use, or POOL_NO_CPU
+ *
+ * @return      Error code
+ * @retval      ERROR_OK            Everything went fine
+ * @retval      ERROR_NULLPTR       The memory could not be allocated
+ * @retval      ERROR_PARAM         Too many options
+ * @retval      ERROR_FORK_FAILED   At least one generator could not be started
+ */
+error_t pool_start(pool_t* pPool, const char* pSelf, size_t cnt, char* const ppOpts[], int consumerCpu)
+{
+    error_t retCode = ERROR_OK;
+    size_t argc = 1U;
+
+    memset(pPool, 0, sizeof(pool_t));
+    pPool->cnt = cnt;
+    pPool->pPids = calloc(sizeof(pid_t), cnt);
+    pPool->pCpus = calloc(sizeof(int), cnt);
+    pPool->pArgv[0] = generator_path(pSelf);
+
+    if ((NULL == pPool->pPids) || (NULL == pPool->pCpus) || (NULL == pPool->pArgv[0]))
+    {
+        pool_stop(pPool);
+        return ERROR_NULLPTR;
+    }
+
+    for (size_t i = 0U; NULL != ppOpts[i]; i++)
+    {
+        if (POOL_MAX_ARGS < (argc + i))
+        {
+            pool_stop(pPool);
+            return ERROR_PARAM;
+        }
+        pPool->pArgv[argc + i] = ppOpts[i];
+    }
+
+    assign_cpus(pPool, consumerCpu);
+
+    for (size_t i = 0U; i < cnt; i++)
+    {
+        retCode |= spawn(pPool, i);
+    }
+
+    return retCode;
+}
+
+/**
+ * @brief       Pool Reap
+ * @details     This method is used to collect the generators which terminated.
+ *              A generator which crashed (killed by a signal or exited with an error) is started again on the same
+ *              CPU, as long as respawn is set and POOL_MAX_RESPAWNS is not reached. A generator which terminated
+ *              normally (the graph is acyclic) is not started again.
+ *              The components which the generator claimed are released first, otherwise nobody would solve them.
+ *              A claim is only dropped if it still belongs to the process, a generator which took it over keeps it.
+ *
+ * @param       pPool       Pointer to the pool
+ * @param       respawn     Crashed generators should be started again
+ * @param       pClaims     Pointer to the claims of the components in the shared memory (atomic), or NULL
+ * @param       claimCnt    Number of claims
+ */
+void pool_reap(pool_t* pPool, bool respawn, pid_t* pClaims, size_t claimCnt)
+{
+    int status = 0;
+    pid_t pid = 0;
+
+    while ((pid = waitpid(-1, &status, WNOHANG)) > 0)
+    {
+        for (size_t i = 0U; i < pPool->cnt; i++)
+        {
+            if (pid != pPool->pPids[i])
+            {
+                continue;
+            }
+
+            pPool->pPids[i] = 0;
+
+            for (size_t c = 0U; (NULL != pClaims) && (c < claimCnt); c++)
+            {
+                pid_t owner = pid;
+
+                (void)__atomic_compare_exchange_n(&pClaims[c], &owner, 0, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+            }
+
+            if (WIFSIGNALED(status) || (WIFEXITED(status) && (EXIT_SUCCESS != WEXITSTATUS(status))))
+            {
+                debug("Generator %zu (pid %d) crashed\n", i, pid);
+
+                if (respawn && (POOL_MAX_RESPAWNS > pPool->respawns))
+                {
+                    pPool->respawns++;
+                    spawn(pPool, i);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief       Pool Stop
+ * @details     This method is used to wait for the generators after they were deactivated (flag in the shared
+ *              memory). Generators which are still running after POOL_STOP_WAIT_MS are terminated. Afterwards
+ *              the memory of the pool is freed.
+ *
+ * @param       pPool       Pointer to the pool
+ */
+void pool_stop(pool_t* pPool)
+{
+    const struct timespec delay = {.tv_sec = 0, .tv_nsec = 10000000L}; /*!< 10ms */
+    size_t running = 0U;
+
+    for (size_t round = 0U; (NULL != pPool->pPids) && (round <= (POOL_STOP_WAIT_MS / 10U)); round++)
+    {
+        pool_reap(pPool, false, NULL, 0U);
+
+        running = 0U;
+        for (size_t i = 0U; i < pPool->cnt; i++)
+        {
+            if (0 != pPool->pPids[i])
+            {
+                running++;
+
+                // last round, they had their chance
+                if ((POOL_STOP_WAIT_MS / 10U) == round)
+                {
+                    kill(pPool->pPids[i], SIGTERM);
+                    waitpid(pPool->pPids[i], NULL, 0);
+                    pPool->pPids[i] = 0;
+                }
+            }
+        }
+
+        if (0U == running)
+        {
+            break;
+        }
+
+        nanosleep(&delay, NULL);
+    }
+
+    free(pPool->pPids);
+    free(pPool->pCpus);
+    free(pPool->pArgv[0]);
+    memset(pPool, 0, sizeof(pool_t));
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+/**
+ * @file  pool.h
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ * @brief Pool of generator processes which are started and watched by the supervisor
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+#include "errors.h"
+
+#define POOL_MAX_RESPAWNS 16U   /*!< Maximum number of crashed generators which are started again */
+#define POOL_MAX_ARGS 4U        /*!< Maximum number of options which are passed to the generators */
+#define POOL_STOP_WAIT_MS 1000U /*!< Time the generators get to terminate on their own before they are killed */
+#define POOL_NO_CPU -1          /*!< The consumer is not pinned */
+
+/*!
+ * @struct pool_t
+ * @brief  Pool of generator processes
+ *
+ * @details Every generator is pinned to one CPU. The CPUs which are allowed for the supervisor are used
+ *          round-robin, the CPU of the consumer is left out as long as there is another one.
+ **/
+typedef struct
+{
+    pid_t* pPids;                       /*!< process id of every generator, 0 if it is not running */
+    size_t cnt;                         /*!< number of generators */
+    char* pArgv[POOL_MAX_ARGS + 2U];    /*!< program and options of the generators, NULL terminated */
+    int* pCpus;                         /*!< CPU of every generator, -1 if it is not pinned */
+    size_t respawns;                    /*!< number of generators which were started again */
+} pool_t;
+
+/* **** FUNCTIONS **** */
+error_t pool_pin(int cpu);
+error_t pool_start(pool_t* pPool, const char* pSelf, size_t cnt, char* const ppOpts[], int consumerCpu);
+void pool_reap(pool_t* pPool, bool respawn, pid_t* pClaims, size_t claimCnt);
+void pool_stop(pool_t* pPool);
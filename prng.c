@@ -0,0 +1,144 @@
+#include "prng.h"
+
+#include <stddef.h>
+
+/**
+ * @file prng.c
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ */
+
+/**
+ * @brief       Rotate Left
+ * @param       x       Value which should be rotated
+ * @param       k       Number of bits
+ * @return      Rotated value
+ */
+static inline uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+/**
+ * @brief       SplitMix64
+ * @details     This internal method is used to expand a single seed into the state of the generator.
+ *              It makes sure that similar seeds still result in completely different states.
+ *
+ * @param       pX      Pointer to the state of the splitmix generator (read and write)
+ *
+ * @return      Next value
+ */
+static uint64_t splitmix64(uint64_t* pX)
+{
+    uint64_t z = (*pX += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief       Jump
+ * @details     This internal method is used to advance the generator by 2^128 steps.
+ *              Streams which are separated by a jump will never overlap in practice.
+ *
+ * @param       pRng    Pointer to the generator
+ */
+static void prng_jump(prng_t* pRng)
+{
+    static const uint64_t JUMP[] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL,
+                                    0x39ABDC4529B1661CULL};
+    uint64_t s[4] = {0U};
+
+    for (size_t i = 0U; i < (sizeof(JUMP) / sizeof(JUMP[0])); i++)
+    {
+        for (int b = 0; b < 64; b++)
+        {
+            if (JUMP[i] & (1ULL << b))
+            {
+                s[0] ^= pRng->s[0];
+                s[1] ^= pRng->s[1];
+                s[2] ^= pRng->s[2];
+                s[3] ^= pRng->s[3];
+            }
+            prng_next(pRng);
+        }
+    }
+
+    pRng->s[0] = s[0];
+    pRng->s[1] = s[1];
+    pRng->s[2] = s[2];
+    pRng->s[3] = s[3];
+}
+
+/**
+ * @brief       PRNG Init
+ * @details     This method is used to initialize a generator.
+ *              All generators with the same seed share one sequence, the stream number selects a part of it which
+ *              does not overlap with the parts of the other streams.
+ *
+ * @param       pRng    Pointer to the generator
+ * @param       seed    Common seed
+ * @param       stream  Number of the stream (e.g. the id of the generator process)
+ */
+void prng_init(prng_t* pRng, uint64_t seed, uint64_t stream)
+{
+    for (size_t i = 0U; i < 4U; i++)
+    {
+        pRng->s[i] = splitmix64(&seed);
+    }
+
+    for (uint64_t i = 0U; i < stream; i++)
+    {
+        prng_jump(pRng);
+    }
+}
+
+/**
+ * @brief       PRNG Next
+ * @details     This method is used to get the next 64 bit random value (xoshiro256**).
+ *
+ * @param       pRng    Pointer to the generator
+ *
+ * @return      Random value
+ */
+uint64_t prng_next(prng_t* pRng)
+{
+    const uint64_t result = rotl(pRng->s[1] * 5U, 7) * 9U;
+    const uint64_t t = pRng->s[1] << 17;
+
+    pRng->s[2] ^= pRng->s[0];
+    pRng->s[3] ^= pRng->s[1];
+    pRng->s[1] ^= pRng->s[2];
+    pRng->s[0] ^= pRng->s[3];
+    pRng->s[2] ^= t;
+    pRng->s[3] = rotl(pRng->s[3], 45);
+
+    return result;
+}
+
+/**
+ * @brief       PRNG Bounded
+ * @details     This method is used to get an unbiased random value in [0, range).
+ *              Lemire's method is used: the random value is multiplied with the range and the upper half is taken,
+ *              only the few values which would cause a bias get rejected. So in almost every case no division is needed.
+ *
+ * @param       pRng    Pointer to the generator
+ * @param       range   Upper bound (exclusive), must not be 0
+ *
+ * @return      Random value
+ */
+uint32_t prng_bounded(prng_t* pRng, uint32_t range)
+{
+    uint64_t m = (prng_next(pRng) >> 32) * (uint64_t)range;
+    uint32_t low = (uint32_t)m;
+
+    if (low < range)
+    {
+        const uint32_t threshold = (uint32_t)(-range) % range;
+
+        while (low < threshold)
+        {
+            m = (prng_next(pRng) >> 32) * (uint64_t)range;
+            low = (uint32_t)m;
+        }
+    }
+
+    return (uint32_t)(m >> 32);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * @file  prng.h
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ * @brief Pseudo random number generator for the generators
+ */
+
+#include <stdint.h>
+
+/*!
+ * @struct prng_t
+ * @brief  State of the pseudo random number generator (xoshiro256**)
+ **/
+typedef struct
+{
+    uint64_t s[4]; /*!< internal state, must not be all zero */
+} prng_t;
+
+/* **** FUNCTIONS **** */
+void prng_init(prng_t* pRng, uint64_t seed, uint64_t stream);
+uint64_t prng_next(prng_t* pRng);
+uint32_t prng_bounded(prng_t* pRng, uint32_t range);
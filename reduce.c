@@ -0,0 +1,364 @@
+#include "reduce.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file reduce.c
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ */
+
+#define REDUCE_NONE UINT32_MAX /*!< end of an adjacency list */
+
+/*!
+ * @struct reduce_work_t
+ * @brief  Working memory of the reduction
+ *
+ * @details The edges are kept in doubly linked adjacency lists, so an edge can be removed or moved to another vertex
+ *          in O(1).
+ **/
+typedef struct
+{
+    vertex_t* pStart;   /*!< start vertex of every edge */
+    vertex_t* pEnd;     /*!< end vertex of every edge (changes when a chain gets contracted) */
+    bool* pAlive;       /*!< edge is still part of the graph */
+    uint32_t* pNextOut; /*!< next edge in the out-list of the start vertex */
+    uint32_t* pPrevOut; /*!< previous edge in the out-list of the start vertex */
+    uint32_t* pNextIn;  /*!< next edge in the in-list of the end vertex */
+    uint32_t* pPrevIn;  /*!< previous edge in the in-list of the end vertex */
+    uint32_t* pHeadOut; /*!< first edge of the out-list of every vertex */
+    uint32_t* pHeadIn;  /*!< first edge of the in-list of every vertex */
+    uint32_t* pDegOut;  /*!< out-degree of every vertex */
+    uint32_t* pDegIn;   /*!< in-degree of every vertex */
+    bool* pQueued;      /*!< vertex is on the stack of the candidates */
+    vertex_t* pStack;   /*!< vertices which have to be looked at */
+    size_t stackCnt;    /*!< number of vertices on the stack */
+} reduce_work_t;
+
+/**
+ * @brief       Link Edge
+ * @details     This internal method is used to put an edge in front of the out-list of its start vertex and the
+ *              in-list of its end vertex.
+ *
+ * @param       pWork   Pointer to the working memory
+ * @param       e       Edge
+ */
+static void link_edge(reduce_work_t* pWork, uint32_t e)
+{
+    vertex_t u = pWork->pStart[e];
+    vertex_t w = pWork->pEnd[e];
+
+    pWork->pPrevOut[e] = REDUCE_NONE;
+    pWork->pNextOut[e] = pWork->pHeadOut[u];
+    if (REDUCE_NONE != pWork->pHeadOut[u])
+    {
+        pWork->pPrevOut[pWork->pHeadOut[u]] = e;
+    }
+    pWork->pHeadOut[u] = e;
+    pWork->pDegOut[u]++;
+
+    pWork->pPrevIn[e] = REDUCE_NONE;
+    pWork->pNextIn[e] = pWork->pHeadIn[w];
+    if (REDUCE_NONE != pWork->pHeadIn[w])
+    {
+        pWork->pPrevIn[pWork->pHeadIn[w]] = e;
+    }
+    pWork->pHeadIn[w] = e;
+    pWork->pDegIn[w]++;
+}
+
+/**
+ * @brief       Unlink Edge
+ * @details     This internal method is used to take an edge out of both adjacency lists.
+ *
+ * @param       pWork   Pointer to the working memory
+ * @param       e       Edge
+ */
+static void unlink_edge(reduce_work_t* pWork, uint32_t e)
+{
+    vertex_t u = pWork->pStart[e];
+    vertex_t w = pWork->pEnd[e];
+
+    if (REDUCE_NONE != pWork->pPrevOut[e])
+    {
+        pWork->pNextOut[pWork->pPrevOut[e]] = pWork->pNextOut[e];
+    }
+    else
+    {
+        pWork->pHeadOut[u] = pWork->pNextOut[e];
+    }
+    if (REDUCE_NONE != pWork->pNextOut[e])
+    {
+        pWork->pPrevOut[pWork->pNextOut[e]] = pWork->pPrevOut[e];
+    }
+    pWork->pDegOut[u]--;
+
+    if (REDUCE_NONE != pWork->pPrevIn[e])
+    {
+        pWork->pNextIn[pWork->pPrevIn[e]] = pWork->pNextIn[e];
+    }
+    else
+    {
+        pWork->pHeadIn[w] = pWork->pNextIn[e];
+    }
+    if (REDUCE_NONE != pWork->pNextIn[e])
+    {
+        pWork->pPrevIn[pWork->pNextIn[e]] = pWork->pPrevIn[e];
+    }
+    pWork->pDegIn[w]--;
+}
+
+/**
+ * @brief       Push
+ * @details     This internal method is used to put a vertex on the stack of the candidates, if one of the reductions
+ *              may apply to it and it is not on the stack already.
+ *
+ * @param       pWork   Pointer to the working memory
+ * @param       v       Vertex
+ */
+static void push(reduce_work_t* pWork, vertex_t v)
+{
+    uint32_t in = pWork->pDegIn[v];
+    uint32_t out = pWork->pDegOut[v];
+
+    if (pWork->pQueued[v] || ((0U == in) && (0U == out)))
+    {
+        return;
+    }
+
+    if ((0U == in) || (0U == out) || ((1U == in) && (1U == out)))
+    {
+        pWork->pQueued[v] = true;
+        pWork->pStack[pWork->stackCnt] = v;
+        pWork->stackCnt++;
+    }
+}
+
+/**
+ * @brief       Strip
+ * @details     This internal method is used to remove a source or sink. None of its edges can be part of a cycle, so
+ *              they are removed and the neighbours may become a source or sink themselves.
+ *
+ * @param       pWork   Pointer to the working memory
+ * @param       v       Vertex without in- or out-edges
+ */
+static void strip(reduce_work_t* pWork, vertex_t v)
+{
+    while (REDUCE_NONE != pWork->pHeadOut[v])
+    {
+        uint32_t e = pWork->pHeadOut[v];
+
+        unlink_edge(pWork, e);
+        pWork->pAlive[e] = false;
+        push(pWork, pWork->pEnd[e]);
+    }
+
+    while (REDUCE_NONE != pWork->pHeadIn[v])
+    {
+        uint32_t e = pWork->pHeadIn[v];
+
+        unlink_edge(pWork, e);
+        pWork->pAlive[e] = false;
+        push(pWork, pWork->pStart[e]);
+    }
+}
+
+/**
+ * @brief       Contract
+ * @details     This internal method is used to bypass a vertex v with exactly one in-edge (u, v) and one out-edge
+ *              (v, w). Every cycle through v uses both edges, so removing either breaks the same cycles. They are
+ *              replaced by the edge (u, w), which stands for the input edge of (u, v).
+ *              The vertex is kept if u is w (the kernel has no loops) or if (u, w) exists already (the kernel has no
+ *              weights, two parallel edges would cost twice).
+ *
+ * @param       pWork   Pointer to the working memory
+ * @param       v       Vertex with in- and out-degree one
+ *
+ * @return      true if the vertex was bypassed
+ */
+static bool contract(reduce_work_t* pWork, vertex_t v)
+{
+    uint32_t eIn = pWork->pHeadIn[v];
+    uint32_t eOut = pWork->pHeadOut[v];
+    vertex_t u = pWork->pStart[eIn];
+    vertex_t w = pWork->pEnd[eOut];
+
+    if (u == w)
+    {
+        return false;
+    }
+
+    for (uint32_t e = pWork->pHeadOut[u]; REDUCE_NONE != e; e = pWork->pNextOut[e])
+    {
+        if (w == pWork->pEnd[e])
+        {
+            return false;
+        }
+    }
+
+    unlink_edge(pWork, eOut);
+    pWork->pAlive[eOut] = false;
+
+    unlink_edge(pWork, eIn);
+    pWork->pEnd[eIn] = w;
+    link_edge(pWork, eIn);
+
+    // the degrees of u and w did not change, so no new candidates
+    return true;
+}
+
+/**
+ * @brief       Reduce Kernel
+ * @details     This method is used to shrink the graph before the search. As long as possible, sources and sinks
+ *              get removed and vertices with a single in- and out-edge get bypassed. Every vertex is handled a
+ *              constant number of times plus the scan for a parallel edge, so it is about O(V + E).
+ *              A vertex with a single in- or out-edge and more edges on the other side is not contracted: the edge of
+ *              the kernel would stand for several input edges and the search has no weights to account for that.
+ *
+ * @param       pEdges      Pointer to the edges of the input (no loops)
+ * @param       edgeCnt     Number of edges
+ * @param       idCnt       Size of the id space (biggest vertex id + 1)
+ * @param       pRed        Pointer to the kernel (write)
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ */
+error_t reduce_kernel(const edge_t* pEdges, size_t edgeCnt, size_t idCnt, reduce_t* pRed)
+{
+    error_t retCode = ERROR_OK;
+    reduce_work_t work = {0};
+    size_t fill = 0U;
+
+    memset(pRed, 0, sizeof(reduce_t));
+    work.pStart = malloc(sizeof(vertex_t) * (edgeCnt + 1U));
+    work.pEnd = malloc(sizeof(vertex_t) * (edgeCnt + 1U));
+    work.pAlive = malloc(sizeof(bool) * (edgeCnt + 1U));
+    work.pNextOut = malloc(sizeof(uint32_t) * (edgeCnt + 1U));
+    work.pPrevOut = malloc(sizeof(uint32_t) * (edgeCnt + 1U));
+    work.pNextIn = malloc(sizeof(uint32_t) * (edgeCnt + 1U));
+    work.pPrevIn = malloc(sizeof(uint32_t) * (edgeCnt + 1U));
+    work.pHeadOut = malloc(sizeof(uint32_t) * (idCnt + 1U));
+    work.pHeadIn = malloc(sizeof(uint32_t) * (idCnt + 1U));
+    work.pDegOut = calloc(sizeof(uint32_t), idCnt + 1U);
+    work.pDegIn = calloc(sizeof(uint32_t), idCnt + 1U);
+    work.pQueued = calloc(sizeof(bool), idCnt + 1U);
+    work.pStack = malloc(sizeof(vertex_t) * (idCnt + 1U));
+
+    if ((NULL == work.pStart) || (NULL == work.pEnd) || (NULL == work.pAlive) || (NULL == work.pNextOut) ||
+        (NULL == work.pPrevOut) || (NULL == work.pNextIn) || (NULL == work.pPrevIn) || (NULL == work.pHeadOut) ||
+        (NULL == work.pHeadIn) || (NULL == work.pDegOut) || (NULL == work.pDegIn) || (NULL == work.pQueued) ||
+        (NULL == work.pStack))
+    {
+        retCode = ERROR_NULLPTR;
+    }
+
+    if (ERROR_OK == retCode)
+    {
+        for (size_t v = 0U; v < idCnt; v++)
+        {
+            work.pHeadOut[v] = REDUCE_NONE;
+            work.pHeadIn[v] = REDUCE_NONE;
+        }
+
+        for (uint32_t e = 0U; e < edgeCnt; e++)
+        {
+            work.pStart[e] = pEdges[e].start;
+            work.pEnd[e] = pEdges[e].end;
+            work.pAlive[e] = true;
+            link_edge(&work, e);
+        }
+
+        for (size_t v = 0U; v < idCnt; v++)
+        {
+            push(&work, (vertex_t)v);
+        }
+
+        while (0U < work.stackCnt)
+        {
+            work.stackCnt--;
+            vertex_t v = work.pStack[work.stackCnt];
+            work.pQueued[v] = false;
+
+            if ((0U == work.pDegIn[v]) && (0U == work.pDegOut[v]))
+            {
+                // removed already with a neighbour
+                continue;
+            }
+
+            if ((0U == work.pDegIn[v]) || (0U == work.pDegOut[v]))
+            {
+                strip(&work, v);
+                pRed->stripped++;
+            }
+            else if ((1U == work.pDegIn[v]) && (1U == work.pDegOut[v]) && contract(&work, v))
+            {
+                pRed->contracted++;
+            }
+        }
+
+        for (uint32_t e = 0U; e < edgeCnt; e++)
+        {
+            pRed->edgeCnt += work.pAlive[e] ? 1U : 0U;
+        }
+
+        pRed->pEdges = malloc(sizeof(edge_t) * (pRed->edgeCnt + 1U));
+        pRed->pOrig = malloc(sizeof(uint32_t) * (pRed->edgeCnt + 1U));
+
+        if ((NULL == pRed->pEdges) || (NULL == pRed->pOrig))
+        {
+            retCode = ERROR_NULLPTR;
+        }
+    }
+
+    if (ERROR_OK == retCode)
+    {
+        // the log: a contracted edge keeps the index of its first input edge
+        for (uint32_t e = 0U; e < edgeCnt; e++)
+        {
+            if (work.pAlive[e])
+            {
+                pRed->pEdges[fill].start = work.pStart[e];
+                pRed->pEdges[fill].end = work.pEnd[e];
+                pRed->pOrig[fill] = e;
+                fill++;
+            }
+        }
+    }
+
+    free(work.pStart);
+    free(work.pEnd);
+    free(work.pAlive);
+    free(work.pNextOut);
+    free(work.pPrevOut);
+    free(work.pNextIn);
+    free(work.pPrevIn);
+    free(work.pHeadOut);
+    free(work.pHeadIn);
+    free(work.pDegOut);
+    free(work.pDegIn);
+    free(work.pQueued);
+    free(work.pStack);
+
+    if (ERROR_OK != retCode)
+    {
+        reduce_free(pRed);
+    }
+
+    return retCode;
+}
+
+/**
+ * @brief       Reduce Free
+ * @details     This method is used to free the memory of the kernel.
+ *
+ * @param       pRed    Pointer to the kernel
+ */
+void reduce_free(reduce_t* pRed)
+{
+    free(pRed->pEdges);
+    free(pRed->pOrig);
+    memset(pRed, 0, sizeof(reduce_t));
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+/**
+ * @file  reduce.h
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ * @brief Reduction of a graph to a smaller kernel with the same minimum feedback arc set
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common.h"
+#include "errors.h"
+
+/*!
+ * @struct reduce_t
+ * @brief  Kernel of a graph and the log to map its solutions back
+ *
+ * @details Every kernel edge stands for exactly one edge of the input (pOrig), so a feedback arc set of the kernel
+ *          maps to one of the input with the same size, and a minimum one stays minimum.
+ **/
+typedef struct
+{
+    edge_t* pEdges;    /*!< edges of the kernel (vertex ids of the input) */
+    uint32_t* pOrig;   /*!< index of the input edge every kernel edge stands for */
+    size_t edgeCnt;    /*!< number of edges of the kernel */
+    size_t stripped;   /*!< number of vertices which were removed because they were a source or sink */
+    size_t contracted; /*!< number of vertices which were removed because they were on a chain */
+} reduce_t;
+
+/* **** FUNCTIONS **** */
+error_t reduce_kernel(const edge_t* pEdges, size_t edgeCnt, size_t idCnt, reduce_t* pRed);
+void reduce_free(reduce_t* pRed);
@@ -0,0 +1,249 @@
+#include "scc.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file scc.c
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ */
+
+#define SCC_UNVISITED UINT32_MAX /*!< index of a vertex which was not reached yet */
+
+/*!
+ * @struct scc_frame_t
+ * @brief  Entry of the explicit call stack of the depth-first search
+ **/
+typedef struct
+{
+    vertex_t v;    /*!< vertex of the frame */
+    uint32_t next; /*!< next outgoing edge of the vertex (index into pOut) */
+} scc_frame_t;
+
+/*!
+ * @struct scc_work_t
+ * @brief  Working memory of the decomposition
+ **/
+typedef struct
+{
+    uint32_t* pIndex;     /*!< discovery index of every vertex, SCC_UNVISITED if not reached yet */
+    uint32_t* pLow;       /*!< smallest index which can be reached from the subtree of the vertex */
+    bool* pOnStack;       /*!< vertex is on the stack of the open components */
+    vertex_t* pStack;     /*!< stack of the open components */
+    size_t stackCnt;      /*!< number of vertices on the stack */
+    scc_frame_t* pFrames; /*!< explicit call stack */
+    size_t frameCnt;      /*!< number of frames */
+    uint32_t counter;     /*!< next discovery index */
+} scc_work_t;
+
+/**
+ * @brief       Visit
+ * @details     This internal method is used to discover a vertex: it gets its index, is put on the stack of the open
+ *              components and gets a frame on the call stack.
+ *
+ * @param       pWork   Pointer to the working memory
+ * @param       pGraph  Pointer to the graph
+ * @param       v       Vertex
+ */
+static void visit(scc_work_t* pWork, const graph_t* pGraph, vertex_t v)
+{
+    pWork->pIndex[v] = pWork->counter;
+    pWork->pLow[v] = pWork->counter;
+    pWork->counter++;
+
+    pWork->pStack[pWork->stackCnt] = v;
+    pWork->stackCnt++;
+    pWork->pOnStack[v] = true;
+
+    pWork->pFrames[pWork->frameCnt].v = v;
+    pWork->pFrames[pWork->frameCnt].next = pGraph->pOutOff[v];
+    pWork->frameCnt++;
+}
+
+/**
+ * @brief       Close Component
+ * @details     This internal method is used to take a finished component from the stack. If it has more than one
+ *              vertex it is cyclic and gets the next component number, otherwise its vertex stays in none.
+ *
+ * @param       pWork   Pointer to the working memory
+ * @param       pScc    Pointer to the decomposition (read and write)
+ * @param       root    Vertex with the smallest index of the component
+ * @param       pFill   Pointer to the number of vertices in pVert (read and write)
+ */
+static void close_component(scc_work_t* pWork, scc_t* pScc, vertex_t root, size_t* pFill)
+{
+    size_t first = pWork->stackCnt;
+
+    // the component is everything on the stack above and including the root
+    do
+    {
+        first--;
+        pWork->pOnStack[pWork->pStack[first]] = false;
+    } while (pWork->pStack[first] != root);
+
+    if ((pWork->stackCnt - first) > 1U)
+    {
+        for (size_t i = first; i < pWork->stackCnt; i++)
+        {
+            pScc->pComp[pWork->pStack[i]] = (uint32_t)pScc->compCnt;
+            pScc->pVert[*pFill] = pWork->pStack[i];
+            (*pFill)++;
+        }
+
+        pScc->compCnt++;
+        pScc->pOff[pScc->compCnt] = (uint32_t)*pFill;
+    }
+
+    pWork->stackCnt = first;
+}
+
+/**
+ * @brief       SCC Find
+ * @details     This method is used to decompose the graph into its strongly connected components (Tarjan).
+ *              The depth-first search uses an explicit stack, so long paths cannot overflow the call stack. Every
+ *              vertex and every edge is looked at once, so it is O(V + E).
+ *              A feedback arc set only needs edges inside the cyclic components, so only they are kept.
+ *
+ * @param       pGraph  Pointer to the graph (adjacency is needed)
+ * @param       pScc    Pointer to the decomposition (write)
+ *
+ * @return      Error code
+ * @retval      ERROR_OK        Everything went fine
+ * @retval      ERROR_NULLPTR   The memory could not be allocated
+ */
+error_t scc_find(const graph_t* pGraph, scc_t* pScc)
+{
+    error_t retCode = ERROR_OK;
+    scc_work_t work = {0};
+    size_t fill = 0U;
+    size_t n = pGraph->idCnt;
+
+    memset(pScc, 0, sizeof(scc_t));
+    pScc->pComp = malloc(sizeof(uint32_t) * (n + 1U));
+    pScc->pOff = malloc(sizeof(uint32_t) * ((n / 2U) + 2U));
+    pScc->pVert = malloc(sizeof(vertex_t) * (n + 1U));
+    work.pIndex = malloc(sizeof(uint32_t) * (n + 1U));
+    work.pLow = malloc(sizeof(uint32_t) * (n + 1U));
+    work.pOnStack = calloc(sizeof(bool), n + 1U);
+    work.pStack = malloc(sizeof(vertex_t) * (n + 1U));
+    work.pFrames = malloc(sizeof(scc_frame_t) * (n + 1U));
+
+    if ((NULL == pScc->pComp) || (NULL == pScc->pOff) || (NULL == pScc->pVert) || (NULL == work.pIndex) ||
+        (NULL == work.pLow) || (NULL == work.pOnStack) || (NULL == work.pStack) || (NULL == work.pFrames))
+    {
+        retCode = ERROR_NULLPTR;
+    }
+
+    if (ERROR_OK == retCode)
+    {
+        pScc->pOff[0] = 0U;
+
+        for (size_t v = 0U; v < n; v++)
+        {
+            pScc->pComp[v] = SCC_NONE;
+            work.pIndex[v] = SCC_UNVISITED;
+        }
+
+        for (size_t root = 0U; root < n; root++)
+        {
+            if (SCC_UNVISITED != work.pIndex[root])
+            {
+                continue;
+            }
+
+            visit(&work, pGraph, (vertex_t)root);
+
+            while (0U < work.frameCnt)
+            {
+                scc_frame_t* pTop = &work.pFrames[work.frameCnt - 1U];
+                vertex_t v = pTop->v;
+
+                if (pTop->next < pGraph->pOutOff[v + 1U])
+                {
+                    vertex_t w = pGraph->pOut[pTop->next];
+                    pTop->next++;
+
+                    if (SCC_UNVISITED == work.pIndex[w])
+                    {
+                        // descend, the frame of v continues with its next edge afterwards
+                        visit(&work, pGraph, w);
+                    }
+                    else if (work.pOnStack[w] && (work.pIndex[w] < work.pLow[v]))
+                    {
+                        work.pLow[v] = work.pIndex[w];
+                    }
+                    continue;
+                }
+
+                // all edges of v are done, return to the parent
+                work.frameCnt--;
+
+                if (work.pLow[v] == work.pIndex[v])
+                {
+                    close_component(&work, pScc, v, &fill);
+                }
+
+                if (0U < work.frameCnt)
+                {
+                    vertex_t parent = work.pFrames[work.frameCnt - 1U].v;
+
+                    if (work.pLow[v] < work.pLow[parent])
+                    {
+                        work.pLow[parent] = work.pLow[v];
+                    }
+                }
+            }
+        }
+
+        // count the edges inside every component
+        pScc->pEdgeCnt = calloc(sizeof(uint32_t), pScc->compCnt + 1U);
+
+        if (NULL == pScc->pEdgeCnt)
+        {
+            retCode = ERROR_NULLPTR;
+        }
+        else
+        {
+            for (size_t v = 0U; v < n; v++)
+            {
+                for (uint32_t i = pGraph->pOutOff[v]; i < pGraph->pOutOff[v + 1U]; i++)
+                {
+                    if ((SCC_NONE != pScc->pComp[v]) && (pScc->pComp[v] == pScc->pComp[pGraph->pOut[i]]))
+                    {
+                        pScc->pEdgeCnt[pScc->pComp[v]]++;
+                    }
+                }
+            }
+        }
+    }
+
+    free(work.pIndex);
+    free(work.pLow);
+    free(work.pOnStack);
+    free(work.pStack);
+    free(work.pFrames);
+
+    if (ERROR_OK != retCode)
+    {
+        scc_free(pScc);
+    }
+
+    return retCode;
+}
+
+/**
+ * @brief       SCC Free
+ * @details     This method is used to free the memory of the decomposition.
+ *
+ * @param       pScc    Pointer to the decomposition
+ */
+void scc_free(scc_t* pScc)
+{
+    free(pScc->pComp);
+    free(pScc->pOff);
+    free(pScc->pVert);
+    free(pScc->pEdgeCnt);
+    memset(pScc, 0, sizeof(scc_t));
+}
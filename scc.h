@@ -0,0 +1,39 @@
+#pragma once
+
+/**
+ * @file  scc.h
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ * @brief Decomposition of the graph into strongly connected components (Tarjan, iterative)
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common.h"
+#include "errors.h"
+#include "graph.h"
+
+#define SCC_NONE UINT32_MAX /*!< component of a vertex which is not part of any cycle */
+
+/*!
+ * @struct scc_t
+ * @brief  Cyclic strongly connected components of a graph
+ *
+ * @details Only components with more than one vertex are kept (loops are not allowed), all other vertices cannot be
+ *          part of a cycle. The vertices of component c are pVert[pOff[c]] .. pVert[pOff[c + 1] - 1].
+ *          The components are numbered in the order Tarjan finishes them, so every process which decomposes the same
+ *          graph gets the same numbers.
+ **/
+typedef struct
+{
+    size_t compCnt;     /*!< number of cyclic components */
+    uint32_t* pComp;    /*!< cyclic component of every vertex id, SCC_NONE if it is in none */
+    uint32_t* pOff;     /*!< offsets into pVert, compCnt + 1 elements */
+    vertex_t* pVert;    /*!< vertices of all cyclic components, grouped by the component */
+    uint32_t* pEdgeCnt; /*!< number of edges inside every component */
+} scc_t;
+
+/* **** FUNCTIONS **** */
+error_t scc_find(const graph_t* pGraph, scc_t* pScc);
+void scc_free(scc_t* pScc);
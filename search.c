@@ -0,0 +1,1116 @@
+#include "search.h"
+
+#include <errno.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "debug.h"
+#include "exact.h"
+
+/**
+ * @file search.c
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ */
+
+/**
+ * @brief   Write Solution
+ * @details This internal method is used to write a solution to the shared memory (or the in-process buffer).
+ *          It is called when a solution was found. It uses semaphores to synchronize the access to the shared memory.
+ *          The whole solution is written as one record (header and packed edges) into the circular buffer, so two
+ *          different solutions cannot get mixed up and only one semaphore operation is needed to publish it.
+ *          After a solution was written the sequence number in the header is increased for the next one.
+ *          If built with CIRBUF_LOCKFREE or CIRBUF_LANES no semaphores are used, the writer waits with a backoff
+ *          while the buffer is full.
+ *
+ * @param   pSharedMem  Pointer to the struct of shared memory
+ * @param   pCirBuf     Pointer to the circular buffer of this generator
+ * @param   pSems       Pointer to the struct of semaphores
+ * @param   pHdr        Pointer to the header of the record, the number of edges has to be set (read and write)
+ * @param   pEdges      Pointer to the array of edges
+ *
+ * @return  retCode     Error code
+ * @retval  ERROR_OK            Everything went fine
+ * @retval  ERROR_SEMAPHORE     Something went wrong with the semaphores
+ */
+static error_t write_solution(shared_mem_t* pSharedMem, shared_mem_circbuf_t* pCirBuf, sems_t* pSems,
+                              record_header_t* pHdr, edge_t* pEdges)
+{
+    error_t retCode = ERROR_OK; /*!< return code for error handling */
+
+#ifndef CIRBUF_NONBLOCKING
+    if (sem_wait(pSems->mutex_write) < 0) return ERROR_SEMAPHORE;
+
+    retCode |= circular_buffer_write(pCirBuf, pSems, pHdr, pEdges);
+
+    if (ERROR_OK != retCode)
+    {
+        debug("Error while writing\n", NULL);
+    }
+    else
+    {
+        // increase the number of solutions
+        __atomic_fetch_add(&pSharedMem->flags.numSols, 1, __ATOMIC_RELAXED);
+        pHdr->seq++;
+    }
+
+    if (sem_post(pSems->mutex_write) < 0) return ERROR_SEMAPHORE;
+#else
+    size_t round = 0U; /*!< number of rounds waited for a free slot */
+
+    // no mutex needed, the slot gets reserved atomically; if the buffer is full wait until the supervisor read something
+    retCode = circular_buffer_write(pCirBuf, pSems, pHdr, pEdges);
+
+    while ((ERROR_CIRBUF_FULL == retCode) && pSharedMem->flags.genActive)
+    {
+        circular_buffer_backoff(&round);
+        retCode = circular_buffer_write(pCirBuf, pSems, pHdr, pEdges);
+    }
+
+    if (ERROR_OK == retCode)
+    {
+        // increase the number of solutions
+        __atomic_fetch_add(&pSharedMem->flags.numSols, 1, __ATOMIC_RELAXED);
+        pHdr->seq++;
+    }
+    else if (ERROR_CIRBUF_FULL == retCode)
+    {
+        // generators got deactivated while waiting, the solution is not needed anymore
+        debug("Solution dropped, generators are not active anymore\n", NULL);
+        retCode = ERROR_OK;
+    }
+    else
+    {
+        debug("Error while writing\n", NULL);
+    }
+#endif
+
+    return retCode;
+}
+
+/**
+ * @brief   Shuffle
+ * @details This internal method is used to shuffle the vertices (Fisher-Yates).
+ *          Every vertex gets swapped with a random vertex in front of it (or itself), so every order of the vertices
+ *          is equally likely.
+ *
+ * @param   pRng        Pointer to the random number generator
+ * @param   pVert       Pointer to the array of vertices (read and write)
+ * @param   vertCnt     Number of vertices
+ */
+static void shuffle(prng_t* pRng, vertex_t pVert[], size_t vertCnt)
+{
+    // mix the vertices in the array
+    for (size_t i = vertCnt; i > 1U; i--)
+    {
+        size_t j = prng_bounded(pRng, (uint32_t)i);
+        vertex_t temp = pVert[i - 1U];
+        pVert[i - 1U] = pVert[j];
+        pVert[j] = temp;
+    }
+}
+
+/**
+ * @brief   Get Solution Limit
+ * @details This internal method is used to get the bound for the size of a solution.
+ *          The supervisor publishes the size of the best solution of every component, every solution which is not
+ *          smaller would be thrown away anyway. Without a known solution the bound is one above the biggest solution
+ *          the supervisor accepts (maxSolSize, set before the generators get active).
+ *
+ * @param   pSharedMem  Pointer to the struct of shared memory
+ * @param   comp        Component of the solution
+ *
+ * @return  limit       Solutions with this number of edges (or more) are not needed
+ */
+static size_t get_solution_limit(shared_mem_t* pSharedMem, uint32_t comp)
+{
+    size_t best = (SHAREDMEM_COMP_CNT > comp) ? __atomic_load_n(&pSharedMem->compBest[comp], __ATOMIC_RELAXED)
+                                              : SIZE_MAX;
+    size_t max = pSharedMem->flags.maxSolSize;
+
+    return (best <= max) ? best : (max + 1U);
+}
+
+/**
+ * @brief   Update Positions
+ * @details This internal method is used to build the inverse of the vertex order.
+ *          After this the position of a vertex in the order can be looked up with its id, so no search is needed.
+ *
+ * @param   pVert       Pointer to the array of vertices (the order)
+ * @param   vertCnt     Number of vertices
+ * @param   pPos        Pointer to the array of positions, indexed by the vertex id (write)
+ */
+static void update_positions(const vertex_t* pVert, size_t vertCnt, vertex_t* pPos)
+{
+    for (size_t i = 0U; i < vertCnt; i++)
+    {
+        pPos[pVert[i]] = (vertex_t)i;
+    }
+}
+
+/**
+ * @brief   Sortout Solution
+ * @details This internal method is used to sort out the solution.
+ *          All edges which have a bigger position for the start vertex than for the end vertex are written to the
+ *          solution. The positions of the vertices are generated by the shuffle method, the classification itself is
+ *          done by the (vectorized) back edge kernel.
+ *
+ * @param   pSearch     Pointer to the bundle of the search
+ * @param   pSolution   Pointer to the array of edges of the solution (write)
+ * @param   limit       Solutions with this number of edges (or more) get discarded
+ * @param   pSolSize    Pointer where the number of edges in the solution gets written to
+ *
+ * @return  retCode     Error code
+ * @retval  ERROR_OK            Everything went fine
+ * @retval  ERROR_LIMIT         The solution has at least limit edges
+ */
+static error_t sortout_solution(search_t* pSearch, edge_t pSolution[], size_t limit, size_t* pSolSize)
+{
+    search_comp_t* pComp = &pSearch->comp;
+    size_t solSize = backedges_classify(&pComp->soa, pSearch->pPos, limit, pSearch->pIdx);
+
+    // abort as soon as the solution cannot be better than the bound
+    if ((0U != solSize) && (limit <= solSize))
+    {
+        return ERROR_LIMIT;
+    }
+
+    for (size_t i = 0U; i < solSize; i++)
+    {
+        // back to the edge of the graph the kernel edge stands for (original ids)
+        pSolution[i] = pComp->pOrig[pSearch->pIdx[i]];
+    }
+
+    *pSolSize = solSize;
+
+    return ERROR_OK;
+}
+
+/**
+ * @brief   Generate Solution
+ * @details This internal method is used to generate a solution for the component of the search.
+ *          The vertices get shuffled, if enabled the greedy heuristic builds the order from them (the shuffled order
+ *          breaks its ties) and the order gets improved by the local search. After that all back edges of the order
+ *          form the solution.
+ *
+ * @param   pSearch     Pointer to the bundle of the search
+ * @param   pSolution   Pointer to the array of edges (write)
+ * @param   limit       Solutions with this number of edges (or more) get discarded
+ * @param   pSolSize    Pointer where the number of edges in the solution gets written to
+ *
+ * @return  retCode     Error code
+ * @retval  ERROR_OK            Everything went fine
+ * @retval  ERROR_LIMIT         The solution is too big
+ */
+static error_t generate_solution(search_t* pSearch, edge_t* pSolution, size_t limit, size_t* pSolSize)
+{
+    error_t retCode = ERROR_OK; /*!< return code for error handling */
+    search_comp_t* pComp = &pSearch->comp;
+
+    // shuffle the vertices and remember where each vertex ended up
+    shuffle(&pSearch->rng, pSearch->pVert, pComp->vertCnt);
+    if (pSearch->useGreedy)
+    {
+        greedy_order(&pSearch->greedy, &pComp->graph, &pSearch->rng, pSearch->pVert, pComp->vertCnt, pSearch->pPos);
+    }
+    else
+    {
+        update_positions(pSearch->pVert, pComp->vertCnt, pSearch->pPos);
+    }
+
+    // move single vertices as long as this removes back edges
+    if (pSearch->localSearch)
+    {
+        localsearch_improve(&pSearch->ls, &pComp->graph, pSearch->pVert, pSearch->pPos);
+    }
+
+    // take the edges which have a bigger position for the start vertex than for the end vertex
+    retCode |= sortout_solution(pSearch, pSolution, limit, pSolSize);
+
+    return retCode;
+}
+
+/**
+ * @brief   Create Graph
+ * @details This internal method is used to build a private adjacency from the edges of the shared graph, if the
+ *          image comes without it.
+ *
+ * @param   pSearch     Pointer to the bundle of the search
+ * @param   idCnt       Size of the id space
+ *
+ * @return  retCode     Error code
+ * @retval  ERROR_OK            Everything went fine
+ * @retval  ERROR_NULLPTR       Something could not be allocated
+ */
+static error_t create_graph(search_t* pSearch, size_t idCnt)
+{
+    error_t retCode = ERROR_OK;
+    edge_t* pEdges = malloc(sizeof(edge_t) * pSearch->edgeCnt);
+
+    if (NULL == pEdges)
+    {
+        return ERROR_NULLPTR;
+    }
+
+    for (size_t i = 0U; i < pSearch->edgeCnt; i++)
+    {
+        pEdges[i].start = pSearch->shm.pStart[i];
+        pEdges[i].end = pSearch->shm.pEnd[i];
+    }
+
+    retCode |= graph_create(pEdges, pSearch->edgeCnt, idCnt, &pSearch->graph);
+    pSearch->ownGraph = (ERROR_OK == retCode);
+    free(pEdges);
+
+    return retCode;
+}
+
+/**
+ * @brief   Open Components
+ * @details This internal method is used to count the components which are not solved yet.
+ *
+ * @param   pSearch     Pointer to the bundle of the search
+ *
+ * @return  Number of components which are not solved
+ */
+static size_t open_components(const search_t* pSearch)
+{
+    size_t open = 0U;
+
+    for (size_t c = 0U; c < pSearch->scc.compCnt; c++)
+    {
+        open += pSearch->pDone[c] ? 0U : 1U;
+    }
+
+    return open;
+}
+
+/**
+ * @brief   Assign Component
+ * @details This internal method is used to choose the component a generator works on.
+ *          The first slots get one component each, so every component gets a solution, a solved one is skipped for
+ *          the next open one. Every further slot goes to the open component with the most edges per generator, so
+ *          big components get more of them. All generators decompose the same graph, so the assignment only depends
+ *          on the slot of the generator.
+ *
+ * @param   pScc    Pointer to the decomposition (at least one component)
+ * @param   slot    Slot of the generator (its id, moved on by the number of generators every time it leaves)
+ * @param   pDone   Pointer to the solved flag of every component
+ *
+ * @return  Number of the component, SCC_NONE if all components are solved
+ */
+static uint32_t assign_component(const scc_t* pScc, size_t slot, const bool* pDone)
+{
+    uint32_t* pLoad = NULL;
+    uint32_t comp = SCC_NONE;
+
+    if (slot < pScc->compCnt)
+    {
+        for (size_t i = 0U; i < pScc->compCnt; i++)
+        {
+            uint32_t c = (uint32_t)((slot + i) % pScc->compCnt);
+
+            if (!pDone[c])
+            {
+                return c;
+            }
+        }
+        return SCC_NONE;
+    }
+
+    pLoad = malloc(sizeof(uint32_t) * pScc->compCnt);
+
+    if (NULL == pLoad)
+    {
+        // no balancing, just one of the open components
+        return assign_component(pScc, slot % pScc->compCnt, pDone);
+    }
+
+    for (size_t c = 0U; c < pScc->compCnt; c++)
+    {
+        pLoad[c] = 1U;
+    }
+
+    for (size_t g = pScc->compCnt; g <= slot; g++)
+    {
+        comp = SCC_NONE;
+
+        for (uint32_t c = 0U; c < pScc->compCnt; c++)
+        {
+            // edges[c] / load[c] > edges[comp] / load[comp]
+            if (!pDone[c] && ((SCC_NONE == comp) ||
+                              (((uint64_t)pScc->pEdgeCnt[c] * pLoad[comp]) > ((uint64_t)pScc->pEdgeCnt[comp] * pLoad[c]))))
+            {
+                comp = c;
+            }
+        }
+
+        if (SCC_NONE == comp)
+        {
+            break;
+        }
+
+        pLoad[comp]++;
+    }
+
+    free(pLoad);
+
+    return comp;
+}
+
+/**
+ * @brief   Build Component
+ * @details This internal method is used to prepare the search of one cyclic component.
+ *          The edges inside the component are taken from the adjacency of the whole graph and get local ids. They are
+ *          reduced to the kernel (reduce_kernel), the search only orders its vertices and the log maps every kernel
+ *          edge back to an edge of the graph. All arrays of the search only need one element per vertex (edge) of the
+ *          kernel, the working memory of the search is allocated for this size.
+ *
+ * @param   pSearch     Pointer to the bundle of the search
+ * @param   comp        Number of the component
+ *
+ * @return  retCode     Error code
+ * @retval  ERROR_OK            Everything went fine
+ * @retval  ERROR_NULLPTR       Something could not be allocated
+ */
+static error_t build_component(search_t* pSearch, uint32_t comp)
+{
+    error_t retCode = ERROR_OK;
+    search_comp_t* pComp = &pSearch->comp;
+    const scc_t* pScc = &pSearch->scc;
+    size_t edgeCnt = pScc->pEdgeCnt[comp];
+    size_t fill = 0U;
+    size_t vertCnt = 0U;
+    vertex_t* pIds = NULL;
+    vertex_t* pKernelIds = NULL;
+    reduce_t red = {0};
+    edge_t* pEdges = malloc(sizeof(edge_t) * edgeCnt);
+
+    if (NULL == pEdges)
+    {
+        return ERROR_NULLPTR;
+    }
+
+    pComp->idx = comp;
+
+    for (uint32_t i = pScc->pOff[comp]; i < pScc->pOff[comp + 1U]; i++)
+    {
+        vertex_t v = pScc->pVert[i];
+
+        for (uint32_t j = pSearch->graph.pOutOff[v]; j < pSearch->graph.pOutOff[v + 1U]; j++)
+        {
+            if (comp == pScc->pComp[pSearch->graph.pOut[j]])
+            {
+                pEdges[fill].start = v;
+                pEdges[fill].end = pSearch->graph.pOut[j];
+                fill++;
+            }
+        }
+    }
+
+    // local ids, the table maps them to the dense ids of the graph
+    retCode |= graph_compact(pEdges, edgeCnt, pEdges, &pIds, &vertCnt);
+
+    if (ERROR_OK == retCode)
+    {
+        retCode |= reduce_kernel(pEdges, edgeCnt, vertCnt, &red);
+    }
+
+    if (ERROR_OK == retCode)
+    {
+        debug_pid("Kernel of component %u: %zu of %zu edges, %zu vertices contracted\n", comp, red.edgeCnt, edgeCnt,
+                  red.contracted);
+        pComp->pOrig = malloc(sizeof(edge_t) * red.edgeCnt);
+        retCode |= (NULL == pComp->pOrig) ? ERROR_NULLPTR : ERROR_OK;
+    }
+
+    if (ERROR_OK == retCode)
+    {
+        for (size_t i = 0U; i < red.edgeCnt; i++)
+        {
+            const edge_t* pIn = &pEdges[red.pOrig[i]];
+
+            pComp->pOrig[i].start = pSearch->pIds[pIds[pIn->start]];
+            pComp->pOrig[i].end = pSearch->pIds[pIds[pIn->end]];
+        }
+
+        // bypassed vertices leave gaps, so the kernel gets its own local ids
+        retCode |= graph_compact(red.pEdges, red.edgeCnt, red.pEdges, &pKernelIds, &pComp->vertCnt);
+    }
+
+    if (ERROR_OK == retCode)
+    {
+        edgeCnt = red.edgeCnt;
+        retCode |= backedges_soa_create(red.pEdges, edgeCnt, &pComp->soa);
+    }
+
+    if ((pSearch->localSearch || pSearch->useGreedy) && (ERROR_OK == retCode))
+    {
+        retCode |= graph_create(red.pEdges, edgeCnt, pComp->vertCnt, &pComp->graph);
+    }
+
+    free(pEdges);
+    free(pIds);
+    free(pKernelIds);
+    reduce_free(&red);
+
+    if (ERROR_OK != retCode)
+    {
+        return retCode;
+    }
+
+    // the order gets shuffled, so every generator needs its own one
+    pSearch->pVert = malloc(sizeof(vertex_t) * pComp->vertCnt);
+
+    // one extra position, the vector kernel loads 32 bit for every 16 bit position
+    pSearch->pPos = calloc(sizeof(vertex_t), pComp->vertCnt + 1U);
+    pSearch->pIdx = malloc(sizeof(uint32_t) * edgeCnt);
+
+    if ((NULL == pSearch->pVert) || (NULL == pSearch->pPos) || (NULL == pSearch->pIdx))
+    {
+        return ERROR_NULLPTR;
+    }
+
+    for (size_t i = 0U; i < pComp->vertCnt; i++)
+    {
+        pSearch->pVert[i] = (vertex_t)i;
+    }
+
+    if (pSearch->localSearch)
+    {
+        retCode |= localsearch_init(&pSearch->ls, &pComp->graph);
+    }
+
+    if (pSearch->useGreedy && (ERROR_OK == retCode))
+    {
+        retCode |= greedy_init(&pSearch->greedy, &pComp->graph);
+    }
+
+    return retCode;
+}
+
+/**
+ * @brief   Release Component
+ * @details This internal method is used to free everything build_component allocated, so another component can be
+ *          built.
+ *
+ * @param   pSearch     Pointer to the bundle of the search
+ */
+static void release_component(search_t* pSearch)
+{
+    if (pSearch->localSearch)
+    {
+        localsearch_free(&pSearch->ls);
+    }
+
+    if (pSearch->useGreedy)
+    {
+        greedy_free(&pSearch->greedy);
+    }
+
+    backedges_soa_free(&pSearch->comp.soa);
+    graph_free(&pSearch->comp.graph);
+    free(pSearch->comp.pOrig);
+    free(pSearch->pVert);
+    free(pSearch->pPos);
+    free(pSearch->pIdx);
+    memset(&pSearch->comp, 0, sizeof(search_comp_t));
+    pSearch->pVert = NULL;
+    pSearch->pPos = NULL;
+    pSearch->pIdx = NULL;
+}
+
+/**
+ * @brief   Component Solved
+ * @details This internal method is used to check if the minimum of a component is known already, either because this
+ *          generator solved it exactly or because the supervisor got a proven solution from another one.
+ *
+ * @param   pSearch     Pointer to the bundle of the search
+ * @param   pSharedMem  Pointer to the shared memory
+ * @param   comp        Number of the component
+ *
+ * @return  true if the component is solved
+ */
+static bool component_solved(search_t* pSearch, shared_mem_t* pSharedMem, uint32_t comp)
+{
+    if ((SHAREDMEM_COMP_CNT > comp) && __atomic_load_n(&pSharedMem->compSolved[comp], __ATOMIC_RELAXED))
+    {
+        pSearch->pDone[comp] = true;
+    }
+
+    return pSearch->pDone[comp];
+}
+
+/**
+ * @brief   Next Component
+ * @details This internal method is used to move the search to the next component which is not solved.
+ *          A generator which leaves its component moves its slot on by the number of generators, so the generators do
+ *          not all pile up on the same component. If there are fewer generators than open components, the slots wrap
+ *          around, so the generators take turns on all of them instead of leaving some without any solution.
+ *
+ * @param   pSearch     Pointer to the bundle of the search
+ * @param   pSharedMem  Pointer to the shared memory
+ * @param   pSlot       Pointer to the slot of the generator (read and write)
+ * @param   move        The generator leaves its component (solved or its slice is over), the slot moves on
+ * @param   pComp       Pointer to the number of the component (write, SCC_NONE if all are solved)
+ * @param   ppSolution  Pointer to the array for the solutions (reallocated to the size of the component)
+ *
+ * @return  retCode     Error code
+ * @retval  ERROR_OK            Everything went fine
+ * @retval  ERROR_NULLPTR       Something could not be allocated
+ */
+static error_t next_component(search_t* pSearch, shared_mem_t* pSharedMem, size_t* pSlot, bool move, uint32_t* pComp,
+                              edge_t** ppSolution)
+{
+    error_t retCode = ERROR_OK;
+    edge_t* pGrown = NULL;
+    size_t open = open_components(pSearch);
+    size_t genCnt = __atomic_load_n(&pSharedMem->flags.genCnt, __ATOMIC_RELAXED);
+
+    if (move)
+    {
+        *pSlot += genCnt;
+
+        if (genCnt < open)
+        {
+            *pSlot %= pSearch->scc.compCnt;
+        }
+    }
+
+    release_component(pSearch);
+    *pComp = assign_component(&pSearch->scc, *pSlot, pSearch->pDone);
+
+    if (SCC_NONE == *pComp)
+    {
+        return ERROR_OK;
+    }
+
+    retCode |= build_component(pSearch, *pComp);
+
+    if (ERROR_OK == retCode)
+    {
+        pGrown = realloc(*ppSolution, sizeof(edge_t) * (pSearch->comp.soa.edgeCnt + 1U));
+        retCode |= (NULL == pGrown) ? ERROR_NULLPTR : ERROR_OK;
+    }
+
+    if (NULL != pGrown)
+    {
+        *ppSolution = pGrown;
+    }
+
+    debug_pid("Searching component %d\n", *pComp);
+
+    return retCode;
+}
+
+/**
+ * @brief   Solve Exact
+ * @details This internal method is used to solve a small component with the exact solver. The optimal order gets
+ *          evaluated like every other order, so the solution is mapped back to the edges of the graph the same way.
+ *
+ * @param   pSearch     Pointer to the bundle of the search
+ * @param   pSolution   Pointer to the array of edges (write)
+ * @param   pSolSize    Pointer where the number of edges in the solution gets written to
+ *
+ * @return  retCode     Error code
+ * @retval  ERROR_OK            Everything went fine
+ * @retval  ERROR_NULLPTR       The memory of the solver could not be allocated
+ */
+static error_t solve_exact(search_t* pSearch, edge_t* pSolution, size_t* pSolSize)
+{
+    error_t retCode = exact_order(&pSearch->comp.soa, pSearch->comp.vertCnt, pSearch->pVert);
+
+    if (ERROR_OK == retCode)
+    {
+        update_positions(pSearch->pVert, pSearch->comp.vertCnt, pSearch->pPos);
+        retCode |= sortout_solution(pSearch, pSolution, SIZE_MAX, pSolSize);
+    }
+
+    return retCode;
+}
+
+/**
+ * @brief   Claim
+ * @details This internal method is used to claim a component for an exact solver, with the process id of the
+ *          generator. A claim of a process which does not exist anymore is taken over, the generator was killed
+ *          before it could send the solution. Generator threads share the process id, but they never end alone.
+ *
+ * @param   pSharedMem  Pointer to the shared memory
+ * @param   comp        Number of the component (smaller than SHAREDMEM_COMP_CNT)
+ *
+ * @return  true if the component is claimed by this generator now
+ */
+static bool claim(shared_mem_t* pSharedMem, uint32_t comp)
+{
+    pid_t self = getpid();
+    pid_t owner = 0;
+
+    if (__atomic_compare_exchange_n(&pSharedMem->compClaimed[comp], &owner, self, false, __ATOMIC_ACQ_REL,
+                                    __ATOMIC_ACQUIRE))
+    {
+        return true;
+    }
+
+    if ((self == owner) || (0 == owner) || (0 == kill(owner, 0)) || (ESRCH != errno))
+    {
+        return false;
+    }
+
+    debug_pid("Claim of component %u taken over from the ended process %d\n", comp, owner);
+
+    return __atomic_compare_exchange_n(&pSharedMem->compClaimed[comp], &owner, self, false, __ATOMIC_ACQ_REL,
+                                       __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief   Claim Exact
+ * @details This internal method is used to decide if this generator solves a small component with the exact solver.
+ *          All generators would get the same result, so only the first one which claims the component solves it and
+ *          the others move on. Components from SHAREDMEM_COMP_CNT on have no claim flag, every generator solves them.
+ *
+ * @param   pSharedMem  Pointer to the shared memory
+ * @param   comp        Number of the component
+ *
+ * @return  true if this generator solves the component
+ */
+static bool claim_exact(shared_mem_t* pSharedMem, uint32_t comp)
+{
+    if (SHAREDMEM_COMP_CNT <= comp)
+    {
+        return true;
+    }
+
+    return claim(pSharedMem, comp);
+}
+
+/**
+ * @brief   Claim Branch and Bound
+ * @details This internal method is used to decide if a component gets solved with the branch and bound.
+ *          This needs a medium component (too big for the exact solver) and a random solution of it as the
+ *          incumbent, without one the tree would not be cut at all. Only one generator claims a component, its workers
+ *          use all the threads of the branch and bound, the other generators keep improving the incumbent meanwhile.
+ *          A generator which gave up on a component does not claim it again, but another one may try.
+ *
+ * @param   pSearch     Pointer to the bundle of the search
+ * @param   pSharedMem  Pointer to the shared memory
+ * @param   comp        Number of the component
+ *
+ * @return  true if this generator runs the branch and bound on the component
+ */
+static bool claim_bnb(const search_t* pSearch, shared_mem_t* pSharedMem, uint32_t comp)
+{
+    if ((0U == pSearch->bnbThreads) || (EXACT_MAX_VERT >= pSearch->comp.vertCnt) ||
+        (BNB_MAX_VERT < pSearch->comp.vertCnt) || (SHAREDMEM_COMP_CNT <= comp) || pSearch->pGivenUp[comp])
+    {
+        return false;
+    }
+
+    if (SIZE_MAX == __atomic_load_n(&pSharedMem->compBest[comp], __ATOMIC_RELAXED))
+    {
+        return false;
+    }
+
+    return claim(pSharedMem, comp);
+}
+
+/**
+ * @brief   Solve Branch and Bound
+ * @details This internal method is used to solve a medium component with the parallel branch and bound. The best
+ *          solution of the supervisor is the incumbent, it is read while the search runs. The search stops if the
+ *          generators should stop, the component gets solved otherwise or BNB_NODE_BUDGET nodes are expanded.
+ *
+ * @param   pSearch     Pointer to the bundle of the search
+ * @param   pSharedMem  Pointer to the shared memory
+ * @param   comp        Number of the component
+ * @param   pSolution   Pointer to the array of edges (write)
+ * @param   pSolSize    Pointer where the number of edges in the solution gets written to
+ *
+ * @return  retCode     Error code
+ * @retval  ERROR_OK            Everything went fine, the solution is minimal
+ * @retval  ERROR_LIMIT         The search was aborted
+ * @retval  ERROR_NULLPTR       The memory of the solver could not be allocated
+ */
+static error_t solve_bnb(search_t* pSearch, shared_mem_t* pSharedMem, uint32_t comp, edge_t* pSolution,
+                         size_t* pSolSize)
+{
+    error_t retCode = ERROR_OK;
+    size_t cost = 0U;
+    bnb_problem_t prob = {.pSoa = &pSearch->comp.soa,
+                          .vertCnt = pSearch->comp.vertCnt,
+                          .threadCnt = pSearch->bnbThreads,
+                          .pIncumbent = &pSharedMem->compBest[comp],
+                          .pActive = &pSharedMem->flags.genActive,
+                          .pSolved = &pSharedMem->compSolved[comp],
+                          .nodeBudget = BNB_NODE_BUDGET};
+
+    retCode |= bnb_solve(&prob, pSearch->pVert, &cost);
+
+    if (ERROR_OK == retCode)
+    {
+        update_positions(pSearch->pVert, pSearch->comp.vertCnt, pSearch->pPos);
+        retCode |= sortout_solution(pSearch, pSolution, SIZE_MAX, pSolSize);
+    }
+
+    return retCode;
+}
+
+/**
+ * @brief   Search Init
+ * @details This method is used to prepare everything which is needed to generate solutions.
+ *          The edges and the adjacency are taken from the shared graph, so they are stored only once for all
+ *          generators. If the shared graph cannot be used, a private copy is built. A binary graph file is mapped
+ *          directly instead. Generator threads get the mapping of the supervisor, it is used without a copy.
+ *          The graph is decomposed into its strongly connected components, the component which gets searched is
+ *          chosen by search_run.
+ *
+ * @note    backedges_init has to be called once before.
+ *
+ * @param   pSearch     Pointer to the bundle of the search (write)
+ * @param   pEdges      Pointer to the array of edges, gets owned by the search (NULL: take the shared graph)
+ * @param   edgeCnt     Number of edges
+ * @param   pShm        Pointer to a mapping of the graph which is used as it is (NULL: map or build it)
+ * @param   pConfig     Pointer to the configuration of the search
+ *
+ * @return  retCode     Error code
+ * @retval  ERROR_OK            Everything went fine
+ * @retval  ERROR_NULLPTR       Something could not be allocated
+ * @retval  ERROR_SHMEM         No edges were given and there is no shared graph
+ */
+error_t search_init(search_t* pSearch, edge_t* pEdges, size_t edgeCnt, const graph_shm_t* pShm,
+                    const search_config_t* pConfig)
+{
+    error_t retCode = ERROR_OK;
+
+    memset(pSearch, 0, sizeof(search_t));
+    pSearch->pEdges = pEdges;
+    pSearch->edgeCnt = edgeCnt;
+    pSearch->localSearch = pConfig->localSearch;
+    pSearch->useGreedy = pConfig->greedy;
+    pSearch->bnbThreads = pConfig->bnbThreads;
+
+    if (NULL != pShm)
+    {
+        // the graph of the caller, it stays mapped as long as the search runs
+        pSearch->shm = *pShm;
+        pSearch->shared = true;
+        pSearch->borrowed = true;
+    }
+    else if ((NULL != pConfig->pFile) && (NULL == pEdges))
+    {
+        // binary graph file, it is mapped and used as it is
+        retCode |= graph_file_map(pConfig->pFile, &pSearch->shm);
+
+        if (ERROR_OK != retCode)
+        {
+            return retCode;
+        }
+        pSearch->shared = true;
+    }
+    else
+    {
+        pSearch->shared = (ERROR_OK == graph_shm_attach(pEdges, edgeCnt, &pSearch->shm));
+    }
+
+    if (pSearch->shared)
+    {
+        // without own edges the size is known only from the shared graph
+        edgeCnt = pSearch->shm.graph.edgeCnt;
+        pSearch->edgeCnt = edgeCnt;
+
+        pSearch->vertCnt = pSearch->shm.vertCnt;
+        pSearch->pIds = (vertex_t*)pSearch->shm.pIds;
+        pSearch->graph = pSearch->shm.graph;
+    }
+    else if (NULL == pEdges)
+    {
+        debug("No edges given and no shared graph available\n", NULL);
+        return ERROR_SHMEM;
+    }
+    else
+    {
+        debug("Shared graph not available, using a private copy\n", NULL);
+
+        // the edges get the dense ids in place
+        retCode |= graph_compact(pEdges, edgeCnt, pEdges, &pSearch->pIds, &pSearch->vertCnt);
+
+        if (ERROR_OK != retCode)
+        {
+            return retCode;
+        }
+
+        retCode |= graph_create(pEdges, edgeCnt, pSearch->vertCnt, &pSearch->graph);
+        pSearch->ownGraph = (ERROR_OK == retCode);
+    }
+
+    // a graph file may come without the adjacency
+    if ((NULL == pSearch->graph.pOutOff) && (ERROR_OK == retCode))
+    {
+        retCode |= create_graph(pSearch, pSearch->vertCnt);
+    }
+
+    // only edges inside the cyclic components can be part of a solution
+    if (ERROR_OK == retCode)
+    {
+        retCode |= scc_find(&pSearch->graph, &pSearch->scc);
+        debug("%zu cyclic components\n", pSearch->scc.compCnt);
+    }
+
+    if (ERROR_OK == retCode)
+    {
+        pSearch->pDone = calloc(sizeof(bool), pSearch->scc.compCnt + 1U);
+        pSearch->pGivenUp = calloc(sizeof(bool), pSearch->scc.compCnt + 1U);
+        retCode |= ((NULL == pSearch->pDone) || (NULL == pSearch->pGivenUp)) ? ERROR_NULLPTR : ERROR_OK;
+    }
+
+    // everything is in the adjacency now
+    free(pSearch->pEdges);
+    pSearch->pEdges = NULL;
+
+    return retCode;
+}
+
+/**
+ * @brief   Search Cleanup
+ * @details This method is used to free everything which was allocated by search_init.
+ *
+ * @param   pSearch     Pointer to the bundle of the search
+ */
+void search_cleanup(search_t* pSearch)
+{
+    // the component is always a private copy
+    release_component(pSearch);
+    scc_free(&pSearch->scc);
+    free(pSearch->pDone);
+    free(pSearch->pGivenUp);
+
+    if (pSearch->ownGraph)
+    {
+        graph_free(&pSearch->graph);
+    }
+
+    if (!pSearch->shared)
+    {
+        free(pSearch->pIds);
+    }
+    else if (!pSearch->borrowed)
+    {
+        graph_shm_detach(&pSearch->shm);
+    }
+
+    free(pSearch->pEdges);
+}
+
+/**
+ * @brief   Search Run
+ * @details This method is used to generate solutions and write them to the circular buffer, as long as the
+ *          generators are active. Every generator works on one cyclic component of the graph, solutions which
+ *          cannot be better than the best one of the supervisor for this component are thrown away but counted.
+ *          A component with a kernel of at most EXACT_MAX_VERT vertices is solved exactly once, the solution is sent
+ *          with RECORD_OPTIMAL. The generator moves on as soon as its component is solved, if all are solved it
+ *          waits until the supervisor stops it. With fewer generators than components it moves on after every
+ *          SEARCH_SLICE orders as well.
+ *          If the graph is acyclic, a solution with 0 edges is written and the search ends.
+ *          It is the main loop of a generator process as well as of a generator thread of the supervisor.
+ *
+ * @param   pSearch     Pointer to the bundle of the search (initialized with search_init)
+ * @param   pSharedMem  Pointer to the shared memory
+ * @param   pCirBuf     Pointer to the circular buffer (lane) to write to
+ * @param   pSems       Pointer to the semaphores
+ *
+ * @return  retCode     Error code
+ * @retval  ERROR_OK            Everything went fine
+ * @retval  ERROR_NULLPTR       The memory for the solution could not be allocated
+ * @retval  ERROR_SIGINT        The writing was interrupted by a signal
+ * @retval  ERROR_SEMAPHORE     Something went wrong with the semaphores
+ */
+error_t search_run(search_t* pSearch, shared_mem_t* pSharedMem, shared_mem_circbuf_t* pCirBuf, sems_t* pSems)
+{
+    error_t retCode = ERROR_OK;                          /*!< return code for error handling */
+    edge_t* solution = NULL;                             /*!< memory to store a solution */
+    size_t solSize = 0U;
+    size_t limit = 0U;                                   /*!< solutions with this size or bigger are not needed */
+    size_t genId = 0U;                                   /*!< id of this generator */
+    record_header_t header = {0};                        /*!< header of the records of this generator */
+    size_t epoch = 0U;                                   /*!< epoch of the seed which is used */
+    ssize_t discarded = 0;                               /*!< discarded solutions which are not counted yet */
+    size_t idleRounds = 0U;                              /*!< rounds waited after all components were solved */
+    size_t slot = 0U;                                    /*!< slot of the component assignment */
+    size_t evaluated = 0U;                               /*!< orders evaluated on the component */
+    bool rotate = false;                                 /*!< move on to give another component a turn */
+    bool leave = false;                                  /*!< move on, another generator solves the component */
+
+    // every generator gets its own stream of the common seed, so no two generators produce the same orders
+    genId = __atomic_fetch_add(&pSharedMem->flags.genCnt, 1U, __ATOMIC_RELAXED);
+    epoch = __atomic_load_n(&pSharedMem->flags.epoch, __ATOMIC_ACQUIRE);
+    prng_init(&pSearch->rng, __atomic_load_n(&pSharedMem->flags.seed, __ATOMIC_RELAXED), genId);
+    header.genId = (uint32_t)genId;
+    header.compCnt = (uint32_t)pSearch->scc.compCnt;
+    slot = genId;
+
+    if (0U == pSearch->scc.compCnt)
+    {
+        // no cycle at all, the empty solution tells the supervisor to terminate
+        debug_pid("Graph is acyclic, terminating now, supervisor will terminate too\n", NULL);
+        return write_solution(pSharedMem, pCirBuf, pSems, &header, NULL);
+    }
+
+    header.comp = SCC_NONE;
+
+    while (__atomic_load_n(&pSharedMem->flags.genActive, __ATOMIC_ACQUIRE))
+    {
+        // nothing left to gain on a solved component, and components without a generator need a turn as well
+        rotate = (SEARCH_SLICE <= evaluated) &&
+                 (__atomic_load_n(&pSharedMem->flags.genCnt, __ATOMIC_RELAXED) < open_components(pSearch));
+
+        if ((SCC_NONE == header.comp) || rotate || leave || component_solved(pSearch, pSharedMem, header.comp))
+        {
+            retCode |= next_component(pSearch, pSharedMem, &slot, SCC_NONE != header.comp, &header.comp, &solution);
+            evaluated = 0U;
+            leave = false;
+
+            if (ERROR_OK != retCode)
+            {
+                break;
+            }
+        }
+        else if (SEARCH_SLICE <= evaluated)
+        {
+            evaluated = 0U;
+        }
+
+        if (SCC_NONE == header.comp)
+        {
+            // all components are solved, the supervisor terminates soon
+            circular_buffer_backoff(&idleRounds);
+            continue;
+        }
+
+        // a small component is solved once and for all, by the generator which claims it
+        if (EXACT_MAX_VERT >= pSearch->comp.vertCnt)
+        {
+            if (false == claim_exact(pSharedMem, header.comp))
+            {
+                // the proven solution of the other generator arrives soon, until then the others need a turn
+                leave = true;
+                circular_buffer_backoff(&idleRounds);
+                continue;
+            }
+
+            retCode |= solve_exact(pSearch, solution, &solSize);
+            pSearch->pDone[header.comp] = true;
+
+            // the supervisor does not accept solutions above its maximum, not even a proven one
+            if ((ERROR_OK == retCode) && (pSharedMem->flags.maxSolSize >= solSize))
+            {
+                debug_pid("Component %u solved exactly with %zu edges\n", header.comp, solSize);
+                header.edgeCnt = (uint32_t)solSize;
+                header.flags = RECORD_OPTIMAL;
+                retCode |= write_solution(pSharedMem, pCirBuf, pSems, &header, solution);
+                header.flags = 0U;
+            }
+
+            if ((ERROR_OK != retCode) && (SHAREDMEM_COMP_CNT > header.comp))
+            {
+                // nobody else would solve it anymore
+                __atomic_store_n(&pSharedMem->compClaimed[header.comp], 0, __ATOMIC_RELEASE);
+            }
+
+            if (ERROR_OK != retCode)
+            {
+                break;
+            }
+            continue;
+        }
+
+        // a medium component with a random solution is solved by the branch and bound, which saturates the cores
+        if (claim_bnb(pSearch, pSharedMem, header.comp))
+        {
+            retCode |= solve_bnb(pSearch, pSharedMem, header.comp, solution, &solSize);
+
+            if (ERROR_OK == retCode)
+            {
+                pSearch->pDone[header.comp] = true;
+
+                if (pSharedMem->flags.maxSolSize >= solSize)
+                {
+                    debug_pid("Component %u solved by branch and bound with %zu edges\n", header.comp, solSize);
+                    header.edgeCnt = (uint32_t)solSize;
+                    header.flags = RECORD_OPTIMAL;
+                    retCode |= write_solution(pSharedMem, pCirBuf, pSems, &header, solution);
+                    header.flags = 0U;
+                }
+            }
+            else if (ERROR_LIMIT == retCode)
+            {
+                // aborted or out of budget, the random search goes on and another generator may try
+                debug_pid("Branch and bound gave up on component %u\n", header.comp);
+                pSearch->pGivenUp[header.comp] = true;
+                __atomic_store_n(&pSharedMem->compClaimed[header.comp], 0, __ATOMIC_RELEASE);
+                retCode = ERROR_OK;
+            }
+
+            if (ERROR_OK != retCode)
+            {
+                break;
+            }
+            continue;
+        }
+
+        // the supervisor received too many duplicates, so continue with the new seed
+        if (epoch != __atomic_load_n(&pSharedMem->flags.epoch, __ATOMIC_ACQUIRE))
+        {
+            epoch = __atomic_load_n(&pSharedMem->flags.epoch, __ATOMIC_ACQUIRE);
+            prng_init(&pSearch->rng, __atomic_load_n(&pSharedMem->flags.seed, __ATOMIC_RELAXED), genId);
+            debug_pid("New seed in epoch %zu\n", epoch);
+        }
+
+        // generate the solution
+        evaluated++;
+        limit = get_solution_limit(pSharedMem, header.comp);
+        retCode |= generate_solution(pSearch, solution, limit, &solSize);
+
+        // if the generated solution is too big, continue with new solution
+        if (ERROR_LIMIT == retCode)
+        {
+            // reset status
+            retCode = ERROR_OK;
+
+            // it was discarded because of the best solution of the supervisor, so count it like a sent one;
+            // the counter line is shared by all generators, so it is only updated every SEARCH_COUNT_BATCH solutions
+            if (pSharedMem->flags.maxSolSize >= limit)
+            {
+                discarded++;
+            }
+
+            if (SEARCH_COUNT_BATCH <= discarded)
+            {
+                __atomic_fetch_add(&pSharedMem->flags.numSols, discarded, __ATOMIC_RELAXED);
+                discarded = 0;
+            }
+            continue;
+        }
+
+        // write the edges to the shared memory
+        header.edgeCnt = (uint32_t)solSize;
+        retCode |= write_solution(pSharedMem, pCirBuf, pSems, &header, solution);
+
+        if (ERROR_OK != retCode)
+        {
+            debug_pid("Exited because of error %d", retCode);
+            break;
+        }
+
+    }
+
+    if (false == pSharedMem->flags.genActive)
+    {
+        debug_pid("Terminating because of flag\n", NULL);
+    }
+
+    __atomic_fetch_add(&pSharedMem->flags.numSols, discarded, __ATOMIC_RELAXED);
+    free(solution);
+
+    return retCode;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+/**
+ * @file  search.h
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ * @brief Search for solutions, used by the generator processes and the generator threads of the supervisor
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "backedges.h"
+#include "bnb.h"
+#include "common.h"
+#include "errors.h"
+#include "graph.h"
+#include "greedy.h"
+#include "localsearch.h"
+#include "prng.h"
+#include "reduce.h"
+#include "scc.h"
+
+#define SEARCH_COUNT_BATCH 64 /*!< Discarded solutions which are counted locally before the shared counter is updated */
+#define SEARCH_SLICE 4096U    /*!< Orders evaluated on a component before moving on, if components outnumber generators */
+
+/**
+ * @brief Configuration of the search
+ */
+typedef struct
+{
+    bool localSearch;  /*!< improve every random order with the local search before it gets evaluated */
+    bool greedy;       /*!< build the orders with the greedy heuristic instead of shuffling */
+    const char* pFile; /*!< binary graph file which gets mapped if no edges are given, or NULL */
+    size_t bnbThreads; /*!< threads of the branch and bound on medium components, 0 to search them randomly only */
+} search_config_t;
+
+/**
+ * @brief Component of the search
+ * @details A generator only orders the vertices of one cyclic component. Its edges and adjacency are a private copy
+ *          of the kernel of the component with local ids (0 .. vertCnt - 1).
+ */
+typedef struct
+{
+    uint32_t idx;      /*!< number of the component in the decomposition */
+    edge_soa_t soa;    /*!< edges of the kernel as structure of arrays (local ids) */
+    graph_t graph;     /*!< adjacency of the kernel, only built for the local search and the greedy order */
+    edge_t* pOrig;     /*!< edge of the graph (original ids) every kernel edge stands for */
+    size_t vertCnt;    /*!< number of vertices of the kernel */
+} search_comp_t;
+
+/**
+ * @brief Bundle of the search
+ * @details This bundle holds the whole graph, its cyclic components, the component which is searched and the
+ *          working memory of the search.
+ */
+typedef struct
+{
+    edge_t* pEdges;     /*!< all edges of the graph, freed after the init */
+    size_t edgeCnt;     /*!< number of edges */
+    graph_t graph;      /*!< adjacency of the whole graph (dense ids), needed for the decomposition */
+    graph_shm_t shm;    /*!< mapping of the shared graph */
+    bool shared;        /*!< ids and graph point into the shared graph (or graph file), they must not be freed */
+    bool borrowed;      /*!< the mapping of the shared graph belongs to the caller and must not be detached */
+    bool ownGraph;      /*!< the adjacency was built privately and has to be freed */
+    size_t vertCnt;     /*!< number of vertices */
+    vertex_t* pIds;     /*!< original id of every vertex, indexed by the dense id */
+    scc_t scc;          /*!< cyclic components of the graph */
+    bool* pDone;        /*!< solved flag of every component, the generator does not search them anymore */
+    bool* pGivenUp;     /*!< the branch and bound ran out of its budget on the component, it is not tried again */
+    search_comp_t comp; /*!< component which is searched */
+    vertex_t* pVert;    /*!< current order of the vertices of the component (local ids) */
+    vertex_t* pPos;     /*!< position of each vertex in the order, indexed by the local id */
+    uint32_t* pIdx;     /*!< indexes of the back edges */
+    prng_t rng;         /*!< random number generator */
+    localsearch_t ls;   /*!< working memory of the local search */
+    greedy_t greedy;    /*!< working memory of the greedy order */
+    bool localSearch;   /*!< local search is enabled */
+    bool useGreedy;     /*!< greedy order is enabled */
+    size_t bnbThreads;  /*!< threads of the branch and bound, 0 if it is disabled */
+} search_t;
+
+/* **** FUNCTIONS **** */
+error_t search_init(search_t* pSearch, edge_t* pEdges, size_t edgeCnt, const graph_shm_t* pShm,
+                    const search_config_t* pConfig);
+void search_cleanup(search_t* pSearch);
+error_t search_run(search_t* pSearch, shared_mem_t* pSharedMem, shared_mem_circbuf_t* pCirBuf, sems_t* pSems);
@@ -0,0 +1,122 @@
+#include "seenset.h"
+
+#include <string.h>
+
+/**
+ * @file seenset.c
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ */
+
+/**
+ * @brief       Mix
+ * @details     This internal method is used to spread the bits of a value over the whole word (finalizer of
+ *              MurmurHash3), so that similar edges get completely different hashes.
+ *
+ * @param       x       Value
+ *
+ * @return      Mixed value
+ */
+static uint64_t mix(uint64_t x)
+{
+    x = (x ^ (x >> 33)) * 0xFF51AFD7ED558CCDULL;
+    x = (x ^ (x >> 33)) * 0xC4CEB9FE1A85EC53ULL;
+    return x ^ (x >> 33);
+}
+
+/**
+ * @brief       Seen Set Clear
+ * @details     This method is used to empty the arena and reset all counters.
+ *
+ * @param       pSet    Pointer to the set
+ */
+void seenset_clear(seenset_t* pSet) { memset(pSet, 0, sizeof(seenset_t)); }
+
+/**
+ * @brief       Seen Set Fingerprint
+ * @details     This method is used to get the fingerprint of a solution.
+ *              Every edge is hashed on its own and the hashes are summed up. The sum does not depend on the order of
+ *              the edges, so the same set of edges always gets the same fingerprint without sorting it first.
+ *
+ * @param       pEdges      Pointer to the edges of the solution
+ * @param       edgeCnt     Number of edges
+ *
+ * @return      Fingerprint, never 0
+ */
+uint64_t seenset_fingerprint(const edge_t* pEdges, size_t edgeCnt)
+{
+    uint64_t fingerprint = mix(edgeCnt);
+
+    for (size_t i = 0U; i < edgeCnt; i++)
+    {
+        fingerprint += mix(((uint64_t)pEdges[i].start << 32) | pEdges[i].end);
+    }
+
+    return (0U == fingerprint) ? 1U : fingerprint;
+}
+
+/**
+ * @brief       Seen Set Insert
+ * @details     This method is used to check if a fingerprint was already seen and to add it if not.
+ *              If the arena reaches SEENSET_MAX_LOAD it gets cleared before, the counters are kept.
+ *
+ * @param       pSet            Pointer to the set
+ * @param       fingerprint     Fingerprint of the solution (not 0)
+ *
+ * @return      true if the fingerprint was already in the set (duplicate)
+ */
+bool seenset_insert(seenset_t* pSet, uint64_t fingerprint)
+{
+    size_t idx = (size_t)mix(fingerprint) & (SEENSET_CAPACITY - 1U);
+
+    pSet->total++;
+    pSet->windowCnt++;
+
+    while (0U != pSet->keys[idx])
+    {
+        if (fingerprint == pSet->keys[idx])
+        {
+            pSet->dups++;
+            pSet->windowDups++;
+            return true;
+        }
+
+        idx = (idx + 1U) & (SEENSET_CAPACITY - 1U);
+    }
+
+    if (SEENSET_MAX_LOAD <= pSet->cnt)
+    {
+        // forget everything, the slot found above is free afterwards too
+        memset(pSet->keys, 0, sizeof(pSet->keys));
+        pSet->cnt = 0U;
+    }
+
+    pSet->keys[idx] = fingerprint;
+    pSet->cnt++;
+
+    return false;
+}
+
+/**
+ * @brief       Seen Set Spike
+ * @details     This method is used to check if the rate of duplicates is too high.
+ *              After SEENSET_WINDOW solutions the window is closed; it was a spike if at least SEENSET_SPIKE_DUPS of
+ *              them were duplicates. A new window is started afterwards.
+ *
+ * @param       pSet    Pointer to the set
+ *
+ * @return      true if the last window was a spike
+ */
+bool seenset_spike(seenset_t* pSet)
+{
+    bool spike = false;
+
+    if (SEENSET_WINDOW <= pSet->windowCnt)
+    {
+        spike = (SEENSET_SPIKE_DUPS <= pSet->windowDups);
+        pSet->windowCnt = 0U;
+        pSet->windowDups = 0U;
+    }
+
+    return spike;
+}
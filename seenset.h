@@ -0,0 +1,42 @@
+#pragma once
+
+/**
+ * @file  seenset.h
+ * @author  Benjamin Mandl (12220853)
+ * @date 2023-11-07
+ * @brief Set of the fingerprints of solutions which were already seen (supervisor)
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common.h"
+
+#define SEENSET_CAPACITY 4096U  /*!< Number of fingerprints in the arena (power of two) */
+#define SEENSET_MAX_LOAD 3072U  /*!< The arena is cleared when this number of fingerprints is reached */
+#define SEENSET_WINDOW 64U      /*!< Number of solutions over which the duplicate rate is measured */
+#define SEENSET_SPIKE_DUPS 48U  /*!< Duplicates in one window which count as a spike */
+
+/*!
+ * @struct seenset_t
+ * @brief  Open-addressing hash set of solution fingerprints (linear probing)
+ *
+ * @details The arena has a fixed size, when it gets too full it is cleared, so old solutions are forgotten.
+ *          A fingerprint of 0 marks an empty entry.
+ **/
+typedef struct
+{
+    uint64_t keys[SEENSET_CAPACITY]; /*!< fingerprints, 0 if the entry is empty */
+    size_t cnt;                      /*!< number of fingerprints in the arena */
+    size_t total;                    /*!< number of solutions which were checked */
+    size_t dups;                     /*!< number of duplicates in total */
+    size_t windowCnt;                /*!< number of solutions in the current window */
+    size_t windowDups;               /*!< number of duplicates in the current window */
+} seenset_t;
+
+/* **** FUNCTIONS **** */
+void seenset_clear(seenset_t* pSet);
+uint64_t seenset_fingerprint(const edge_t* pEdges, size_t edgeCnt);
+bool seenset_insert(seenset_t* pSet, uint64_t fingerprint);
+bool seenset_spike(seenset_t* pSet);
@@ -5,16 +5,25 @@
  */
 
 #include <getopt.h>
+#include <pthread.h>
 #include <semaphore.h>
 #include <signal.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 
 #include "common.h"
+#include "compbest.h"
 #include "debug.h"
+#include "edgeparse.h"
 #include "errors.h"
+#include "graph.h"
+#include "lowerbound.h"
+#include "pool.h"
+#include "search.h"
+#include "seenset.h"
 
 /**
  * @brief Bundle of options
@@ -25,13 +34,40 @@ typedef struct
     bool print;      /*!< boolean value of the graph should be printed */
     size_t limit;  /*!< number of generated solutions */
     uint16_t delayS; /*!< delay [s] before the starting to read the buffer */
+    const char* pFile; /*!< file with the edges ("-" for stdin) which gets shared with the generators, or NULL */
+    size_t maxSolSize; /*!< biggest solution which is accepted, 0 for the capacity of the circular buffer */
+    bool reseed;       /*!< generators get a new seed if too many duplicates are received */
+    size_t threads;    /*!< number of generator threads, 0 for generator processes */
+    size_t procs;      /*!< number of generator processes which are started by the supervisor, 0 for none */
+    bool pin;          /*!< the consumer is pinned to consumerCpu */
+    int consumerCpu;   /*!< CPU of the consumer (the main loop of the supervisor) */
+    size_t cells;      /*!< number of cells of every circular buffer (power of two) */
+    bool huge;         /*!< the shared memory should be backed by huge pages */
+    search_config_t search; /*!< configuration of the generator threads or processes */
 } options_t;
 
+/**
+ * @brief Generator thread
+ * @details This bundle holds everything a generator thread of the supervisor needs.
+ */
+typedef struct
+{
+    pthread_t thread;               /*!< handle of the thread */
+    bool started;                   /*!< thread was created and has to be joined */
+    search_t search;                /*!< bundle of the search of this thread */
+    shared_mem_t* pSharedMem;       /*!< in-process memory with the flags and the circular buffer */
+    sems_t* pSems;                  /*!< in-process semaphores */
+    const graph_shm_t* pShm;        /*!< graph of the supervisor, shared by all threads */
+    const search_config_t* pConfig; /*!< configuration of the search */
+    error_t retCode;                /*!< result of the thread */
+} worker_t;
+
 /**
  * @brief Signal Interrupt
  * @details This global boolean flag is used to check if a signal interrupt happened
  */
 static bool gSigInt = false; /*!< Signal Interrupt */
+static bool gChildExit = false; /*!< A generator process of the pool terminated */
 static const char* gAppName; /*!< Name of the application */
 
 /**
@@ -42,7 +78,7 @@ static const char* gAppName; /*!< Name of the application */
 static void usage(char* msg)
 {
     // print the usage message
-    fprintf(stderr, "%s\nUsage: %s [-n limit] [-w delay]\n", msg, gAppName);
+    fprintf(stderr, "%s\nUsage: %s [-n limit] [-w delay] [-f file] [-m max] [-r] [-t threads | -g generators] [-l] [-e] [-x threads] [-c cpu] [-b cells] [-H]\n", msg, gAppName);
     emit_error(msg, ERROR_PARAM);
 }
 
@@ -52,6 +88,8 @@ static void usage(char* msg)
  * @details This internal method is used to read the option given by the user.
  *
  * @warning For the limit and the delay a maximum of 65535 can be used, which would be around 1000h of delay....
+ *          The biggest accepted solution is limited by the capacity of the circular buffer (CIRBUF_RECORD_MAX).
+ *          The number of cells has to be a power of two between CIRBUF_MIN_CELLS and CIRBUF_MAX_CELLS.
  *
  * @param   argc    Argument Counter
  * @param   argv    Argument Variables
@@ -64,7 +102,7 @@ static void handle_opts(int argc, char* argv[], options_t* pOpts)
     // unlimited solutions per default
     pOpts->limit = 0U;
 
-    while ((ret = getopt(argc, argv, "pn:w:")) != -1)
+    while ((ret = getopt(argc, argv, "pn:w:f:m:rt:leg:c:b:Hx:")) != -1)
     {
         switch (ret)
         {
@@ -102,6 +140,128 @@ static void handle_opts(int argc, char* argv[], options_t* pOpts)
                 break;
             }
 
+            // File with the edges
+            case 'f': {
+                if (NULL != pOpts->pFile)
+                {
+                    usage("Option was given more than once\n");
+                }
+                pOpts->pFile = optarg;
+                break;
+            }
+
+            // Biggest accepted solution
+            case 'm': {
+                if (0U != pOpts->maxSolSize)
+                {
+                    usage("Option was given more than once\n");
+                }
+                pOpts->maxSolSize = (size_t)strtol(optarg, NULL, 0);
+                break;
+            }
+
+            // Reseed the generators on a spike of duplicates
+            case 'r': {
+                if (false != pOpts->reseed)
+                {
+                    usage("Option was given more than once\n");
+                }
+                pOpts->reseed = true;
+                break;
+            }
+
+            // Generator threads instead of processes
+            case 't': {
+                if (0U != pOpts->threads)
+                {
+                    usage("Option was given more than once\n");
+                }
+                pOpts->threads = (size_t)strtol(optarg, NULL, 0);
+                break;
+            }
+
+            // Generator processes started by the supervisor
+            case 'g': {
+                if (0U != pOpts->procs)
+                {
+                    usage("Option was given more than once\n");
+                }
+                pOpts->procs = (size_t)strtol(optarg, NULL, 0);
+                break;
+            }
+
+            // CPU of the consumer
+            case 'c': {
+                if (false != pOpts->pin)
+                {
+                    usage("Option was given more than once\n");
+                }
+                pOpts->pin = true;
+                pOpts->consumerCpu = (int)strtol(optarg, NULL, 0);
+                break;
+            }
+
+            // Cells of every circular buffer
+            case 'b': {
+                if (0U != pOpts->cells)
+                {
+                    usage("Option was given more than once\n");
+                }
+                pOpts->cells = (size_t)strtol(optarg, NULL, 0);
+
+                if ((CIRBUF_MIN_CELLS > pOpts->cells) || (CIRBUF_MAX_CELLS < pOpts->cells) ||
+                    (0U != (pOpts->cells & (pOpts->cells - 1U))))
+                {
+                    usage("The number of cells has to be a power of two (16 .. 1048576)\n");
+                }
+                break;
+            }
+
+            // Huge pages for the shared memory
+            case 'H': {
+                if (false != pOpts->huge)
+                {
+                    usage("Option was given more than once\n");
+                }
+                pOpts->huge = true;
+                break;
+            }
+
+            // Local search of the generator threads or processes
+            case 'l': {
+                if (false != pOpts->search.localSearch)
+                {
+                    usage("Option was given more than once\n");
+                }
+                pOpts->search.localSearch = true;
+                break;
+            }
+
+            // Greedy order of the generator threads or processes
+            case 'e': {
+                if (false != pOpts->search.greedy)
+                {
+                    usage("Option was given more than once\n");
+                }
+                pOpts->search.greedy = true;
+                break;
+            }
+
+            // Threads of the branch and bound of the generator threads or processes
+            case 'x': {
+                if (0U != pOpts->search.bnbThreads)
+                {
+                    usage("Option was given more than once\n");
+                }
+                pOpts->search.bnbThreads = (size_t)strtol(optarg, NULL, 0);
+
+                if (0U == pOpts->search.bnbThreads)
+                {
+                    usage("The branch and bound needs at least one thread\n");
+                }
+                break;
+            }
+
             // Unknown option
             default: {
                 usage("Unknown option\n");
@@ -109,6 +269,34 @@ static void handle_opts(int argc, char* argv[], options_t* pOpts)
             }
         }
     }
+
+    if (0U == pOpts->cells)
+    {
+        pOpts->cells = CIRBUF_DEFAULT_CELLS;
+    }
+
+    // a solution has to fit into the circular buffer
+    if ((0U == pOpts->maxSolSize) || (CIRBUF_RECORD_MAX(pOpts->cells) < pOpts->maxSolSize))
+    {
+        pOpts->maxSolSize = CIRBUF_RECORD_MAX(pOpts->cells);
+    }
+
+    if ((0U != pOpts->threads) && (0U != pOpts->procs))
+    {
+        usage("Generator threads and processes cannot be used together\n");
+    }
+
+    // the threads and the started generators take the graph of the supervisor
+    if (((0U != pOpts->threads) || (0U != pOpts->procs)) && (NULL == pOpts->pFile))
+    {
+        usage("Generator threads and processes need the graph as file\n");
+    }
+
+    if ((0U == pOpts->threads) && (0U == pOpts->procs) && (pOpts->search.localSearch || pOpts->search.greedy ||
+                                                            (0U != pOpts->search.bnbThreads)))
+    {
+        usage("The options of the search are only used by generator threads and processes\n");
+    }
 }
 
 /**
@@ -118,12 +306,13 @@ static void handle_opts(int argc, char* argv[], options_t* pOpts)
  *          After that the semaphores will be created and stored in the given bundle.
  *
  * @param   pSems   Pointer to the semaphore bundle
+ * @param   cells   Number of cells of the circular buffer (all are free at the start)
  *
  * @return  error_t Error Code
  * @retval  ERROR_OK            Everything was successful
  * @retval  ERROR_SEMAPHORE     Something was wrong with opening the semaphores
  */
-static error_t init_semaphores(sems_t* pSems)
+static error_t init_semaphores(sems_t* pSems, size_t cells)
 {
     error_t retCode = ERROR_OK;
 
@@ -135,7 +324,7 @@ static error_t init_semaphores(sems_t* pSems)
     // create the named semaphores
     pSems->mutex_write = sem_open(SEM_NAME_MUTEX, O_CREAT, 0666, 1);           // 1 = available for one to write
     pSems->reading = sem_open(SEM_NAME_READ, O_CREAT, 0666, 0);                // 0 = empty
-    pSems->writing = sem_open(SEM_NAME_WRITE, O_CREAT, 0666, CIRBUF_BUFSIZE);  // CIRBUF_BUFSIZE = full
+    pSems->writing = sem_open(SEM_NAME_WRITE, O_CREAT, 0666, (unsigned int)cells); // cells = all free
 
     // check if the opening was successful
     if ((SEM_FAILED == pSems->reading) || (SEM_FAILED == pSems->mutex_write) || (SEM_FAILED == pSems->writing))
@@ -220,6 +409,207 @@ static error_t cleanup_semaphores(sems_t* pSems)
     return retCode;
 }
 
+/**
+ * @brief   Handle Child Exit
+ * @details This internal method is used to handle the termination of a generator process of the pool.
+ *          It only sets the global flag, the process is collected by the main loop.
+ *
+ * @param   sig     Signal which was received
+ */
+static void handle_sigchld(int32_t sig)
+{
+    gChildExit = true;
+}
+
+/**
+ * @brief   Release Writers
+ * @details This internal method is used to give free cells to writers which wait for the full circular buffer
+ *          after the generators were deactivated. Nobody reads anymore, so every generator gets enough cells to
+ *          finish its last solution and see the flag. A writer sends at most one more record, which is not bigger
+ *          than the biggest accepted solution.
+ *
+ * @param   pSems       Pointer to the semaphores
+ * @param   cnt         Number of generators which are still running
+ * @param   maxSolSize  Biggest solution which is accepted
+ */
+static void release_writers(sems_t* pSems, size_t cnt, size_t maxSolSize)
+{
+#ifndef CIRBUF_NONBLOCKING
+    for (size_t i = 0U; i < (cnt * CIRBUF_RECORD_CELLS(maxSolSize)); i++)
+    {
+        sem_post(pSems->writing);
+    }
+#else
+    (void)pSems;
+    (void)cnt;
+    (void)maxSolSize;
+#endif
+}
+
+/**
+ * @brief   Initialize Local Semaphores
+ * @details This internal method is used to initialize unnamed semaphores for the generator threads.
+ *          They have the same initial values as the named ones, but live in the memory of the supervisor, so no
+ *          semaphore has to be opened in the file system.
+ *
+ * @param   pSems       Pointer to the semaphore bundle
+ * @param   localSems   Memory of the three semaphores
+ * @param   cells       Number of cells of the circular buffer (all are free at the start)
+ *
+ * @return  error_t Error Code
+ * @retval  ERROR_OK            Everything was successful
+ * @retval  ERROR_SEMAPHORE     Something was wrong with initializing the semaphores
+ */
+static error_t init_local_semaphores(sems_t* pSems, sem_t localSems[3], size_t cells)
+{
+    pSems->mutex_write = &localSems[0];
+    pSems->reading = &localSems[1];
+    pSems->writing = &localSems[2];
+
+    if ((sem_init(pSems->mutex_write, 0, 1) < 0) || (sem_init(pSems->reading, 0, 0) < 0) ||
+        (sem_init(pSems->writing, 0, (unsigned int)cells) < 0))
+    {
+        debug("Semaphore Init error: %d\n", errno);
+        return ERROR_SEMAPHORE;
+    }
+
+    return ERROR_OK;
+}
+
+/**
+ * @brief   Cleanup Local Semaphores
+ * @details This internal method is used to destroy the unnamed semaphores of the generator threads.
+ *          All threads have to be joined before.
+ *
+ * @param   pSems   Pointer to the semaphore bundle
+ */
+static void cleanup_local_semaphores(sems_t* pSems)
+{
+    sem_destroy(pSems->writing);
+    sem_destroy(pSems->reading);
+    sem_destroy(pSems->mutex_write);
+}
+
+/**
+ * @brief   Worker Main
+ * @details This internal method is the entry point of a generator thread.
+ *          It takes a circular buffer (lane), runs the same search as a generator process on the graph of the
+ *          supervisor and gives the lane back at the end.
+ *
+ * @param   pArg    Pointer to the bundle of the thread
+ *
+ * @return  NULL, the result is stored in the bundle
+ */
+static void* worker_main(void* pArg)
+{
+    worker_t* pWorker = pArg;
+    shared_mem_circbuf_t* pCirBuf = NULL;
+
+    pWorker->retCode = circular_buffer_attach(pWorker->pSharedMem, &pCirBuf);
+
+    if (ERROR_OK != pWorker->retCode)
+    {
+        debug("No free circular buffer lane left for a thread\n", NULL);
+        return NULL;
+    }
+
+    pWorker->retCode = search_init(&pWorker->search, NULL, 0U, pWorker->pShm, pWorker->pConfig);
+
+    if (ERROR_OK == pWorker->retCode)
+    {
+        pWorker->retCode = search_run(&pWorker->search, pWorker->pSharedMem, pCirBuf, pWorker->pSems);
+    }
+
+    search_cleanup(&pWorker->search);
+    circular_buffer_detach(pCirBuf);
+
+    return NULL;
+}
+
+/**
+ * @brief   Block Signals
+ * @details This internal method is used to block SIGINT and SIGTERM while threads are created, so they inherit the
+ *          mask and only the main thread handles them.
+ *
+ * @param   pOld    Pointer where the old mask gets written to, it has to be restored after the threads were created
+ */
+static void block_signals(sigset_t* pOld)
+{
+    sigset_t block;
+
+    sigemptyset(&block);
+    sigaddset(&block, SIGINT);
+    sigaddset(&block, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &block, pOld);
+}
+
+/**
+ * @brief   Start Workers
+ * @details This internal method is used to start the generator threads.
+ *          The signals are blocked while the threads are created, so only the main thread handles SIGINT and SIGTERM.
+ *
+ * @param   pWorkers    Pointer to the array of thread bundles
+ * @param   cnt         Number of threads
+ *
+ * @return  error_t Error Code
+ * @retval  ERROR_OK            Everything was successful
+ * @retval  ERROR_PARAM         A thread could not be created
+ */
+static error_t start_workers(worker_t* pWorkers, size_t cnt)
+{
+    error_t retCode = ERROR_OK;
+    sigset_t old;
+
+    block_signals(&old);
+
+    for (size_t i = 0U; i < cnt; i++)
+    {
+        pWorkers[i].started = (0 == pthread_create(&pWorkers[i].thread, NULL, worker_main, &pWorkers[i]));
+
+        if (!pWorkers[i].started)
+        {
+            debug("Thread %zu could not be created\n", i);
+            retCode = ERROR_PARAM;
+        }
+    }
+
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+    return retCode;
+}
+
+/**
+ * @brief   Stop Workers
+ * @details This internal method is used to wait for the generator threads, the generators have to be deactivated
+ *          before. A thread may wait for free cells of the full circular buffer, which nobody reads anymore, so
+ *          enough cells are given to the writers that every thread can finish its last solution.
+ *
+ * @param   pWorkers    Pointer to the array of thread bundles
+ * @param   cnt         Number of threads
+ * @param   pSems       Pointer to the semaphores
+ * @param   maxSolSize  Biggest solution which is accepted
+ */
+static void stop_workers(worker_t* pWorkers, size_t cnt, sems_t* pSems, size_t maxSolSize)
+{
+    size_t started = 0U;
+
+    for (size_t i = 0U; i < cnt; i++)
+    {
+        started += pWorkers[i].started ? 1U : 0U;
+    }
+
+    release_writers(pSems, started, maxSolSize);
+
+    for (size_t i = 0U; i < cnt; i++)
+    {
+        if (pWorkers[i].started)
+        {
+            pthread_join(pWorkers[i].thread, NULL);
+            debug("Thread %zu finished with %d\n", i, pWorkers[i].retCode);
+        }
+    }
+}
+
 /**
  * @brief   Handle Signal Interrupt
  * @details This internal method is used to handle the signal interrupt.
@@ -234,28 +624,159 @@ static void handle_sigint(int32_t sig)
     debug("SIGINT received\n", NULL);
 }
 
+/**
+ * @brief   Get Random Seed
+ * @details This internal method is used to get a seed for the random number generators from the time and the pid.
+ *
+ * @return  seed        Random seed
+ */
+static uint64_t get_random_seed(void)
+{
+    struct timespec now = {0};
+
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    return ((uint64_t)now.tv_sec << 32) ^ (uint64_t)now.tv_nsec ^ ((uint64_t)getpid() << 16);
+}
+
+/**
+ * @brief   Huge Size
+ * @details This internal method is used to round a size up to whole huge pages.
+ *
+ * @param   size    Size in byte
+ *
+ * @return  Rounded size in byte
+ */
+static size_t huge_size(size_t size)
+{
+    return (size + SHAREDMEM_HUGE_PAGE - 1U) & ~(SHAREDMEM_HUGE_PAGE - 1U);
+}
+
+/**
+ * @brief   Map Huge Shared Memory
+ * @details This internal method is used to create the shared memory as a file in the hugetlbfs, so it is backed by
+ *          huge pages. The generators find it there if there is no POSIX shared memory.
+ *          If the hugetlbfs is not mounted or there are not enough huge pages reserved, the file is removed again.
+ *
+ * @param   pFd     Pointer to the file descriptor
+ * @param   size    Size of the memory in byte (whole huge pages)
+ *
+ * @return  Pointer to the mapping, NULL if it could not be created
+ */
+static shared_mem_t* map_huge_shmem(int16_t* pFd, size_t size)
+{
+    shared_mem_t* pSharedMem = NULL;
+
+    *pFd = open(SHAREDMEM_HUGE_DIR "/" SHAREDMEM_FILE, O_RDWR | O_CREAT | O_EXCL, 0600);
+
+    if (*pFd < 0)
+    {
+        debug("Opening in the hugetlbfs failed %d\n", errno);
+        return NULL;
+    }
+
+    if (ftruncate(*pFd, (off_t)size) == 0)
+    {
+        pSharedMem = (shared_mem_t*)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, *pFd, 0);
+    }
+
+    if ((NULL == pSharedMem) || (MAP_FAILED == pSharedMem))
+    {
+        debug("Mapping of huge pages failed %d\n", errno);
+        close(*pFd);
+        unlink(SHAREDMEM_HUGE_DIR "/" SHAREDMEM_FILE);
+        return NULL;
+    }
+
+    return pSharedMem;
+}
+
+/**
+ * @brief   Map Local Memory
+ * @details This internal method is used to allocate the memory of the flags and the circular buffers for the
+ *          generator threads. It is private to the process, but mapped like the shared memory, so it is aligned to a
+ *          page and can be backed by huge pages. If there are no huge pages, normal pages are used and the flag is
+ *          reset.
+ *
+ * @param   cells   Number of cells of every circular buffer
+ * @param   pHuge   Pointer to the flag of huge pages (read and write)
+ * @param   pSize   Pointer where the size of the mapping gets written to
+ *
+ * @return  Pointer to the mapping, NULL if it could not be created
+ */
+static shared_mem_t* map_local_shmem(size_t cells, bool* pHuge, size_t* pSize)
+{
+    shared_mem_t* pSharedMem = MAP_FAILED;
+
+    if (*pHuge)
+    {
+        *pSize = huge_size(shared_mem_size(cells));
+        pSharedMem = (shared_mem_t*)mmap(NULL, *pSize, PROT_READ | PROT_WRITE,
+                                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+        if (MAP_FAILED == pSharedMem)
+        {
+            fprintf(stderr, "No huge pages available, normal pages are used\n");
+            *pHuge = false;
+        }
+    }
+
+    if (!*pHuge)
+    {
+        *pSize = shared_mem_size(cells);
+        pSharedMem = (shared_mem_t*)mmap(NULL, *pSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+
+    return (MAP_FAILED == pSharedMem) ? NULL : pSharedMem;
+}
+
 /**
  * @brief   Initialize Shared Memory
  * @details This internal method is used to initialize the shared memory.
  *          If there is already a shared memory, it will be unlinked first.
  *          After that the shared memory will be created (file descriptor) and mapped to an address.
  *          The opening as a file descriptor is allowed to fail once. Further the memory is truncated to the size of
- *          the shared memory struct.
- *          After that the memory is reset to 0 and the file descriptor is closed.
+ *          the header and all circular buffers with the given number of cells.
+ *          With huge pages the memory is a file in the hugetlbfs instead, its size is rounded up to whole huge pages.
+ *          If that is not possible, the normal shared memory is used and the flag is reset.
+ *          After that the memory is reset, the layout is written to the header and the file descriptor is closed.
  *
  * @param   pSharedMem  Pointer to the shared memory
  * @param   pFd         Pointer to the file descriptor
+ * @param   cells       Number of cells of every circular buffer
+ * @param   pHuge       Pointer to the flag of huge pages (read and write)
+ * @param   pSize       Pointer where the size of the mapping gets written to
  *
  * @return  error_t Error Code
  * @retval  ERROR_OK            Everything was successful
  * @retval  ERROR_SHMEM         Something was wrong with the shared memory
  */
-static error_t init_shmem(shared_mem_t** pSharedMem, int16_t* pFd)
+static error_t init_shmem(shared_mem_t** pSharedMem, int16_t* pFd, size_t cells, bool* pHuge, size_t* pSize)
 {
     error_t retCode = ERROR_OK;
 
-    // unlink the shared memory if a file already exists
+    // unlink the shared memory if a file already exists, also the graph of the last run
     shm_unlink(SHAREDMEM_FILE);
+    unlink(SHAREDMEM_HUGE_DIR "/" SHAREDMEM_FILE);
+    shm_unlink(GRAPH_SHM_FILE);
+
+    if (*pHuge)
+    {
+        *pSize = huge_size(shared_mem_size(cells));
+        *pSharedMem = map_huge_shmem(pFd, *pSize);
+
+        if (NULL != *pSharedMem)
+        {
+            retCode |= shared_mem_init(*pSharedMem, cells, *pSize);
+            close(*pFd);
+            return retCode;
+        }
+
+        fprintf(stderr, "No huge pages available, normal pages are used\n");
+        *pHuge = false;
+    }
+
+    *pSize = shared_mem_size(cells);
 
     // open the shared memory
     *pFd = shm_open(SHAREDMEM_FILE, O_RDWR | O_CREAT, 0600);
@@ -282,7 +803,7 @@ static error_t init_shmem(shared_mem_t** pSharedMem, int16_t* pFd)
         }
     }
 
-    if (ftruncate(*pFd, sizeof(shared_mem_t)) < 0)
+    if (ftruncate(*pFd, (off_t)*pSize) < 0)
     {
         debug("ftruncate failed\n", NULL);
         retCode = ERROR_SHMEM;
@@ -290,7 +811,7 @@ static error_t init_shmem(shared_mem_t** pSharedMem, int16_t* pFd)
     }
 
     // map the shared memory
-    *pSharedMem = (shared_mem_t*)mmap(NULL, sizeof(shared_mem_t), PROT_READ | PROT_WRITE, MAP_SHARED, *pFd, 0);
+    *pSharedMem = (shared_mem_t*)mmap(NULL, *pSize, PROT_READ | PROT_WRITE, MAP_SHARED, *pFd, 0);
 
     // check if the mapping was successful
     if (MAP_FAILED == *pSharedMem)
@@ -301,64 +822,166 @@ static error_t init_shmem(shared_mem_t** pSharedMem, int16_t* pFd)
     }
 
     // if everything was successful, reset the memory
-    memset(*pSharedMem, 0, sizeof(shared_mem_t));
+    retCode |= shared_mem_init(*pSharedMem, cells, *pSize);
     close(*pFd);
 
     return retCode;
 }
 
+#ifdef CIRBUF_LANES
+/**
+ * @brief   Read Lanes
+ * @details This internal method is used to read one solution from the lanes of the generators.
+ *          The lanes are polled round-robin, starting after the lane which was read last time, so that no generator
+ *          gets starved.
+ *
+ * @param   pSharedMem  Pointer to the shared memory
+ * @param   pSems       Pointer to the semaphores
+ * @param   pHdr        Pointer to the header of the record
+ * @param   pEdges      Pointer to the array of edges
+ * @param   maxEdges    Number of edges the array can hold
+ *
+ * @return  error_t Error Code
+ * @retval  ERROR_OK            Everything was successful
+ * @retval  ERROR_LIMIT         The array is too small, the header holds the needed size
+ * @retval  ERROR_CIRBUF_EMPTY  All lanes are empty
+ */
+static error_t read_lanes(shared_mem_t* pSharedMem, sems_t* pSems, record_header_t* pHdr, edge_t* pEdges,
+                          size_t maxEdges)
+{
+    static size_t nextLane = 0U; /*!< lane to start with */
+    error_t retCode = ERROR_CIRBUF_EMPTY;
+
+    for (size_t i = 0U; (i < CIRBUF_LANE_CNT) && (ERROR_CIRBUF_EMPTY == retCode); i++)
+    {
+        size_t lane = (nextLane + i) % CIRBUF_LANE_CNT;
+
+        retCode = circular_buffer_read(shared_mem_ring(pSharedMem, lane), pSems, pHdr, pEdges, maxEdges);
+
+        // a record which is too big stays in its lane, so the same lane is read again with the bigger array
+        if ((ERROR_CIRBUF_EMPTY != retCode) && (ERROR_LIMIT != retCode))
+        {
+            nextLane = (lane + 1U) % CIRBUF_LANE_CNT;
+        }
+    }
+
+    return retCode;
+}
+#endif
+
 /**
  * @brief   Get Solution
  * @details This internal method is used to get a solution from the shared memory.
- *          It will read the edges from the shared memory until it finds the delimiter.
- *          The edges will be stored in the given array.
+ *          A whole solution is stored in one record of the circular buffer, so it is read at once.
+ *          The method does not wait forever, if nothing was written ERROR_CIRBUF_EMPTY is returned, so that the
+ *          caller can check its termination conditions.
+ *          The edges will be stored in the given array. If the solution does not fit, the array is grown to the
+ *          size of the solution and the solution is read again.
  *
  * @param   pSharedMem  Pointer to the shared memory
  * @param   pSems       Pointer to the semaphores
- * @param   pEdges      Pointer to the array of edges
+ * @param   pEdges      Pointer to the array of edges (may be reallocated)
+ * @param   pCapacity   Pointer to the number of edges the array can hold (may be increased)
  * @param   pEdgeCnt    Pointer to the number of edges
+ * @param   pHeader     Pointer where the header of the record gets written to (component of the solution)
  *
  * @return  error_t Error Code
  * @retval  ERROR_OK            Everything was successful
- * @retval  ERROR_CIRBUF_EMPTY  The circular buffer is empty
+ * @retval  ERROR_NULLPTR       The array could not be grown
+ * @retval  ERROR_CIRBUF_EMPTY  No solution was available
+ * @retval  ERROR_SIGINT        The reading was interrupted by a signal
+ * @retval  ERROR_SEMAPHORE     Something was wrong with the semaphores
  */
-static error_t get_solution(shared_mem_t* pSharedMem, sems_t* pSems, edge_t* pEdges[], size_t* pEdgeCnt)
+static error_t get_solution(shared_mem_t* pSharedMem, sems_t* pSems, edge_t* pEdges[], size_t* pCapacity,
+                            size_t* pEdgeCnt, record_header_t* pHeader)
 {
-    error_t retCode = ERROR_OK;
-    edge_t currEdge = {0U};
-    size_t iter = 0;
+    error_t retCode = ERROR_LIMIT;
+    record_header_t header = {0};
+
     *pEdgeCnt = SIZE_MAX;  // set max value, due to interrupt
 
-    while (true)
+    while (ERROR_LIMIT == retCode)
     {
-        retCode |= circular_buffer_read(&pSharedMem->circbuf, pSems, &currEdge);
+#ifdef CIRBUF_LANES
+        retCode = read_lanes(pSharedMem, pSems, &header, *pEdges, *pCapacity);
+#else
+        retCode = circular_buffer_read(shared_mem_ring(pSharedMem, 0U), pSems, &header, *pEdges, *pCapacity);
+#endif
 
-        if (ERROR_SEMAPHORE == retCode)
-        {
-            return retCode;
-        }
-        
-        if (is_edge_delimiter(currEdge))
+        if (ERROR_LIMIT == retCode)
         {
-            break;
-        }
+            // the record is still in the buffer, so grow the array to its size and read it again
+            edge_t* pGrown = realloc(*pEdges, sizeof(edge_t) * header.edgeCnt);
 
-        if (retCode != ERROR_OK)
-        {
-            debug("Error while reading\n", NULL);
-            return retCode;
-        } else
-        {
-            memcpy(&(*pEdges)[iter], &currEdge, sizeof(edge_t));
-            iter++;
+            if (NULL == pGrown)
+            {
+                retCode = ERROR_NULLPTR;
+                break;
+            }
+
+            *pEdges = pGrown;
+            *pCapacity = header.edgeCnt;
         }
     }
 
-    *pEdgeCnt = iter;
+    if (ERROR_OK == retCode)
+    {
+        *pEdgeCnt = header.edgeCnt;
+        *pHeader = header;
+        debug("Solution %" PRIu64 " of generator %u for component %u with %u edges\n", header.seq, header.genId,
+              header.comp, header.edgeCnt);
+    }
+
+    if ((ERROR_OK != retCode) && (ERROR_CIRBUF_EMPTY != retCode))
+    {
+        debug("Error while reading\n", NULL);
+        *pEdgeCnt = SIZE_MAX;
+    }
 
     return retCode;
 }
 
+/**
+ * @brief   Apply Bounds
+ * @details This internal method is used to compare the best solution of every component with its lower bound.
+ *          A component whose best solution meets the bound is proven, its generators move on to other components.
+ *          The bounds are only used if the engine decomposed the graph into the same components as the generators.
+ *
+ * @param   pLb         Pointer to the lower bound engine
+ * @param   pBest       Pointer to the best solutions of the components
+ * @param   pSharedMem  Pointer to the shared memory
+ */
+static void apply_bounds(const lowerbound_t* pLb, compbest_t* pBest, shared_mem_t* pSharedMem)
+{
+    if (pLb->scc.compCnt != pBest->compCnt)
+    {
+        return;
+    }
+
+    for (size_t c = 0U; c < pBest->compCnt; c++)
+    {
+        if (compbest_bound(pBest, c, lowerbound_get(pLb, c)) && (SHAREDMEM_COMP_CNT > c))
+        {
+            debug("Component %zu proven by its lower bound\n", c);
+            __atomic_store_n(&pSharedMem->compSolved[c], true, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/**
+ * @brief   Reseed Generators
+ * @details This internal method is used to tell the generators to continue with a new seed.
+ *          The seed is written before the epoch is increased, so a generator which sees the new epoch also sees
+ *          the new seed.
+ *
+ * @param   pSharedMem  Pointer to the shared memory
+ */
+static void reseed_generators(shared_mem_t* pSharedMem)
+{
+    __atomic_store_n(&pSharedMem->flags.seed, get_random_seed(), __ATOMIC_RELAXED);
+    __atomic_fetch_add(&pSharedMem->flags.epoch, 1U, __ATOMIC_RELEASE);
+}
+
 /**
  * @brief   Print Solution
  * @details This internal method is used to print a solution.
@@ -380,20 +1003,107 @@ static void print_solution(edge_t* pEdges, size_t edgeCnt)
     fprintf(stderr, "Solution with %zu edges:", edgeCnt);
     for (size_t i = 0; i < edgeCnt; i++)
     {
-        fprintf(stderr, " %d-%d", pEdges[i].start, pEdges[i].end);
+        fprintf(stderr, " %" PRIvertex "-%" PRIvertex, pEdges[i].start, pEdges[i].end);
     }
     fprintf(stderr, "%s", "\n");
 }
 
+/**
+ * @brief   Load Graph
+ * @details This internal method is used to read the graph from the file (text or binary) and put it into the shared
+ *          graph.
+ *          The generators can be started without edges then, they take the graph from the shared memory.
+ *          Generator threads use the graph of the supervisor, so it is built in private memory for them.
+ *
+ * @param   pPath           Path to the file ("-" for stdin)
+ * @param   pShm            Pointer to the mapping of the graph (write)
+ * @param   privateGraph    Keep the graph in the process, instead of the shared graph
+ *
+ * @return  error_t Error Code
+ * @retval  ERROR_OK            Everything was successful
+ * @retval  ERROR_FILE          The file could not be read
+ * @retval  ERROR_PARAM         The file has an invalid edge or a loop
+ * @retval  ERROR_SHMEM         The shared graph could not be created
+ */
+static error_t load_graph(const char* pPath, graph_shm_t* pShm, bool privateGraph)
+{
+    error_t retCode = ERROR_OK;
+    edge_t* pEdges = NULL;
+    size_t edgeCnt = 0U;
+    graph_shm_t image = {0};
+
+    if (graph_file_is_image(pPath))
+    {
+        // binary graph file, the edges only have to be copied with their original ids
+        retCode |= graph_file_map(pPath, &image);
+        edgeCnt = image.graph.edgeCnt;
+        pEdges = (ERROR_OK == retCode) ? malloc(sizeof(edge_t) * edgeCnt) : NULL;
+        retCode |= ((ERROR_OK == retCode) && (NULL == pEdges)) ? ERROR_NULLPTR : ERROR_OK;
+
+        for (size_t i = 0U; (ERROR_OK == retCode) && (i < edgeCnt); i++)
+        {
+            pEdges[i].start = image.pIds[image.pStart[i]];
+            pEdges[i].end = image.pIds[image.pEnd[i]];
+        }
+
+        graph_shm_detach(&image);
+    }
+    else
+    {
+        retCode |= edgeparse_file(pPath, &pEdges, &edgeCnt);
+    }
+
+    for (size_t i = 0U; (ERROR_OK == retCode) && (i < edgeCnt); i++)
+    {
+        // check for loop
+        if (pEdges[i].start == pEdges[i].end)
+        {
+            retCode |= ERROR_PARAM;
+        }
+    }
+
+    if ((ERROR_OK == retCode) && privateGraph)
+    {
+        retCode |= graph_private_create(pEdges, edgeCnt, pShm);
+        debug("Private graph with %zu edges created\n", edgeCnt);
+    }
+    else if (ERROR_OK == retCode)
+    {
+        retCode |= graph_shm_attach(pEdges, edgeCnt, pShm);
+        debug("Shared graph with %zu edges created\n", edgeCnt);
+    }
+
+    // everything is in the shared graph now
+    free(pEdges);
+
+    return retCode;
+}
+
 /**
  * @brief   Main Function
  * @details This is the main function of the supervisor.
  *          The supervisor is responsible for reading the shared memory and determining the best solution.
- *          It will read the edges from the shared memory until it finds the delimiter. These read edges form a "solution".
- *          The supervisor will compare the size of the current solution with the best solution and store the smaller one.
- *          If a solution with 0 edges is found, the graph is acyclic and therefore the program can terminate.
+ *          It will read whole solutions (one record of the circular buffer each) from the shared memory.
+ *          The arrays of the solutions start small and grow with the biggest solution which was read.
+ *          Solutions which were already received (same set of edges) are skipped. With the option -r the generators
+ *          get a new seed if most of the solutions in a row were duplicates.
+ *          With the option -t the generators run as threads of the supervisor. They use the graph of the supervisor,
+ *          which is built in its private memory, and an in-process circular buffer with unnamed semaphores. Nothing
+ *          but the graph file is opened in the file system for them, the segments of another instance are left alone.
+ *          With the option -g the supervisor starts the generator processes itself, pins each to a CPU and starts
+ *          crashed ones again. With -c the main loop (the consumer of the circular buffer) is pinned too.
+ *          The generators search the cyclic components of the graph separately, so every solution belongs to one
+ *          component. The supervisor keeps the best solution of every component, as soon as every component has
+ *          one their union is a solution of the whole graph, which gets smaller with every better component.
+ *          If a generator reports that there is no cyclic component, the graph is acyclic and therefore the program
+ *          can terminate. It terminates as well as soon as the solutions of all components are proven minimum.
+ *          With the option -x the generators solve medium components with a branch and bound on that many threads,
+ *          starting from the best random solution of the component.
+ *          If the supervisor has the graph (-f), a thread of it packs edge-disjoint cycles into every component. As
+ *          soon as the best solution of a component meets this lower bound, the component is proven as well.
  *
- * @note    The supervisor will terminate if the optional limit is reached or if a signal interrupt is received.
+ * @note    The supervisor will terminate if the optional limit is reached (even without a solution of the whole
+ *          graph, then none is printed) or if a signal interrupt is received.
  *
  * @param   argc    Argument Counter
  * @param   argv    Argument Variables
@@ -412,7 +1122,30 @@ int main(int argc, char* argv[])
     edge_t* currSol = {0U};        /* current solution */
     size_t bestSolSize = SIZE_MAX; /* size of the best solution */
     size_t currSolSize = SIZE_MAX; /* size of the current solution */
+    size_t bestSolCap = BEST_SOL_ARRAY_SIZE; /* number of edges bestSol can hold */
+    size_t currSolCap = BEST_SOL_ARRAY_SIZE; /* number of edges currSol can hold */
     int16_t fd = -1;               /* file descriptor of the shared memory */
+    size_t shmSize = 0U;           /* size of the mapping of the shared memory */
+    graph_shm_t graphShm = {0};    /* shared graph, only if it was loaded from a file */
+    seenset_t* pSeen = NULL;       /* fingerprints of the received solutions */
+    record_header_t currHdr = {0}; /* header of the current solution */
+    compbest_t compBest = {0};     /* best solution of every cyclic component */
+    bool improved = false;         /* current solution is the best of its component */
+    bool proven = false;           /* best solution is a proven minimum */
+    lowerbound_t lowerBound = {0}; /* lower bounds of the components, only if the graph was loaded from a file */
+    uint64_t boundVersion = 0U;    /* version of the lower bounds which was applied last */
+    bool recheck = false;          /* a component got a better solution, which might meet its lower bound */
+    sigset_t oldMask;              /* signal mask of the main thread while the engine is started */
+    bool duplicate = false;        /* current solution was already received */
+    worker_t* pWorkers = NULL;     /* generator threads, only with -t */
+    sem_t localSems[3];            /* unnamed semaphores of the generator threads */
+    pool_t pool = {0};             /* generator processes, only with -g */
+    char* genOpts[5] = {NULL};     /* options of the generator processes */
+    char bnbArg[24] = {0};         /* threads of the branch and bound as option of the generator processes */
+    size_t genOptCnt = 0U;         /* number of options of the generator processes */
+#ifdef CIRBUF_NONBLOCKING
+    size_t idleRounds = 0U;        /* number of reads in a row without a solution */
+#endif
 
     // set the application name
     gAppName = argv[0];
@@ -420,8 +1153,9 @@ int main(int argc, char* argv[])
     // allocate the memory for the solutions
     bestSol = calloc(sizeof(edge_t), BEST_SOL_ARRAY_SIZE);
     currSol = calloc(sizeof(edge_t), BEST_SOL_ARRAY_SIZE);
+    pSeen = calloc(sizeof(seenset_t), 1U);
 
-    if ((bestSol == NULL) || (currSol == NULL))
+    if ((bestSol == NULL) || (currSol == NULL) || (pSeen == NULL))
     {
         emit_error("Something was wrong with allocating memory\n", retCode);
     }
@@ -433,21 +1167,144 @@ int main(int argc, char* argv[])
 
     /* get the options */
     handle_opts(argc, argv, &opts);
-    debug("Options: Print: %d, Limit: %d, Delay: %d\n", opts.print, opts.limit, opts.delayS);
+    debug("Options: Print: %d, Limit: %zu, Delay: %d, Max: %zu\n", opts.print, opts.limit, opts.delayS,
+          opts.maxSolSize);
+
+    if (0U != opts.threads)
+    {
+        // everything stays in the process, the threads do not need named semaphores or shared memory
+        pWorkers = calloc(sizeof(worker_t), opts.threads);
+
+        // the layout of the shared memory relies on cache line aligned members, a mapping is aligned to a page
+        pSharedMem = map_local_shmem(opts.cells, &opts.huge, &shmSize);
+
+        if ((NULL == pWorkers) || (NULL == pSharedMem))
+        {
+            emit_error("Something was wrong with allocating memory\n", ERROR_NULLPTR);
+        }
+
+        retCode |= shared_mem_init(pSharedMem, opts.cells, shmSize);
+        retCode |= init_local_semaphores(&semaphores, localSems, opts.cells);
+
+        if (ERROR_OK != retCode)
+        {
+            emit_error("Something was wrong with creating the semaphores\n", retCode);
+        }
+    }
+    else
+    {
+        retCode |= init_semaphores(&semaphores, opts.cells);
+        debug("Semaphores initialized\n", NULL);
+
+        if (ERROR_OK != retCode)
+        {
+            emit_error("Something was wrong with creating the semaphores\n", retCode);
+        }
+
+        retCode |= init_shmem(&pSharedMem, &fd, opts.cells, &opts.huge, &shmSize);
+        debug("Shared Memory initialized: fd: %d, addr: %d\n", fd, pSharedMem);
+
+        if (ERROR_OK != retCode)
+        {
+            cleanup_semaphores(&semaphores);
+            emit_error("Something was wrong with the shared memory\n", retCode);
+        }
+    }
+
+    // the graph must be there before the generators get active
+    if (NULL != opts.pFile)
+    {
+        retCode |= load_graph(opts.pFile, &graphShm, 0U != opts.threads);
+
+        if ((ERROR_OK != retCode) && (0U != opts.threads))
+        {
+            emit_error("Something was wrong with loading the graph\n", retCode);
+        }
+        else if (ERROR_OK != retCode)
+        {
+            munmap(pSharedMem, shmSize);
+            shm_unlink(SHAREDMEM_FILE);
+            unlink(SHAREDMEM_HUGE_DIR "/" SHAREDMEM_FILE);
+            shm_unlink(GRAPH_SHM_FILE);
+            cleanup_semaphores(&semaphores);
+            emit_error("Something was wrong with loading the graph\n", retCode);
+        }
+    }
 
-    retCode |= init_semaphores(&semaphores);
-    debug("Semaphores initialized\n", NULL);
+    // every generator uses its own stream of this seed
+    pSharedMem->flags.seed = get_random_seed();
 
-    if (ERROR_OK != retCode)
+    // the lower bounds are packed next to the search, they need the graph of the supervisor
+    if (NULL != opts.pFile)
     {
-        emit_error("Something was wrong with creating the semaphores\n", retCode);
+        block_signals(&oldMask);
+
+        if (ERROR_OK != lowerbound_start(&lowerBound, &graphShm.graph, pSharedMem->compSolved,
+                                         pSharedMem->flags.seed))
+        {
+            fprintf(stderr, "The lower bounds could not be started, optimality is only known from the solvers\n");
+        }
+
+        pthread_sigmask(SIG_SETMASK, &oldMask, NULL);
     }
 
-    retCode |= init_shmem(&pSharedMem, &fd);
-    debug("Shared Memory initialized: fd: %d, addr: %d\n", fd, pSharedMem);
+    // no solution known yet, so generators may send everything up to the biggest accepted solution
+    pSharedMem->flags.maxSolSize = opts.maxSolSize;
 
     // set the flag that the generators should be active
-    pSharedMem->flags.genActive = true;
+    __atomic_store_n(&pSharedMem->flags.genActive, true, __ATOMIC_RELEASE);
+
+    if (0U != opts.threads)
+    {
+        backedges_init();
+
+        for (size_t i = 0U; i < opts.threads; i++)
+        {
+            pWorkers[i].pSharedMem = pSharedMem;
+            pWorkers[i].pSems = &semaphores;
+            pWorkers[i].pShm = &graphShm;
+            pWorkers[i].pConfig = &opts.search;
+        }
+
+        if (ERROR_OK != start_workers(pWorkers, opts.threads))
+        {
+            fprintf(stderr, "Not all generator threads could be started\n");
+        }
+    }
+
+    if (0U != opts.procs)
+    {
+        struct sigaction saChld = {.sa_handler = handle_sigchld};
+        sigaction(SIGCHLD, &saChld, NULL);
+
+        if (opts.search.localSearch)
+        {
+            genOpts[genOptCnt++] = "-l";
+        }
+
+        if (opts.search.greedy)
+        {
+            genOpts[genOptCnt++] = "-e";
+        }
+
+        if (0U != opts.search.bnbThreads)
+        {
+            snprintf(bnbArg, sizeof(bnbArg), "%zu", opts.search.bnbThreads);
+            genOpts[genOptCnt++] = "-x";
+            genOpts[genOptCnt++] = bnbArg;
+        }
+
+        // before the consumer gets pinned, the generators are spread over all CPUs the supervisor may use
+        if (ERROR_OK != pool_start(&pool, argv[0], opts.procs, genOpts, opts.pin ? opts.consumerCpu : POOL_NO_CPU))
+        {
+            fprintf(stderr, "Not all generator processes could be started\n");
+        }
+    }
+
+    if (opts.pin && (ERROR_OK != pool_pin(opts.consumerCpu)))
+    {
+        fprintf(stderr, "The consumer could not be pinned to cpu %d\n", opts.consumerCpu);
+    }
 
     if (opts.delayS > 0U)
     {
@@ -460,32 +1317,134 @@ int main(int argc, char* argv[])
     debug("Starting main loop\n", NULL);
 
     // main loop
-    // SIZE_MAX is the indicator for unlimited solutions
-    while ((false == gSigInt) && ((pSharedMem->flags.numSols < opts.limit) || (opts.limit == 0U)))
+    // 0 is the indicator for unlimited solutions, the limit holds even if not every component has a solution yet
+    while ((false == gSigInt) && (((size_t)pSharedMem->flags.numSols < opts.limit) || (opts.limit == 0U)))
     {
-        // reset the memory
-        memset(currSol, 0, sizeof(edge_t) * BEST_SOL_ARRAY_SIZE);
         currSolSize = SIZE_MAX;
 
+        // a better lower bound or a better solution can prove a component, checked even if no solution arrives
+        if (recheck || (boundVersion != lowerbound_version(&lowerBound)))
+        {
+            boundVersion = lowerbound_version(&lowerBound);
+            recheck = false;
+            apply_bounds(&lowerBound, &compBest, pSharedMem);
+
+            if (compbest_proven(&compBest))
+            {
+                proven = true;
+                break;
+            }
+        }
+
+        // collect terminated generators of the pool and start crashed ones again
+        if (gChildExit)
+        {
+            gChildExit = false;
+            pool_reap(&pool, true, pSharedMem->compClaimed, SHAREDMEM_COMP_CNT);
+        }
+
         // check if there is something to read, and further if semaphores are successful
-        retCode |= get_solution(pSharedMem, &semaphores, &currSol, &currSolSize);
+        retCode |= get_solution(pSharedMem, &semaphores, &currSol, &currSolCap, &currSolSize, &currHdr);
+
+        if ((ERROR_SIGINT == retCode) && (false == gSigInt))
+        {
+            // interrupted by the termination of a generator, not by the user
+            retCode = ERROR_CIRBUF_EMPTY;
+        }
+
+        if (ERROR_CIRBUF_EMPTY == retCode)
+        {
+            // nothing to read at the moment, check the termination conditions again
+            retCode = ERROR_OK;
+#ifdef CIRBUF_NONBLOCKING
+            circular_buffer_backoff(&idleRounds);
+#endif
+            continue;
+        }
+
+#ifdef CIRBUF_NONBLOCKING
+        idleRounds = 0U;
+#endif
 
         if (ERROR_OK != retCode)
         {
             debug("Error while reading: %d\n", retCode);
             break;
         }
-        
-        if (currSolSize < bestSolSize)
+
+        // identical solutions (mostly of different generators) only have to be handled once
+        duplicate = seenset_insert(pSeen, seenset_fingerprint(currSol, currSolSize));
+
+        if (opts.reseed && seenset_spike(pSeen))
+        {
+            debug("Duplicate spike, reseeding generators\n", NULL);
+            reseed_generators(pSharedMem);
+        }
+
+        // a proven record still counts if a random generator sent the same edges before, it marks the component
+        if (duplicate && (0U == (currHdr.flags & RECORD_OPTIMAL)))
+        {
+            continue;
+        }
+
+        // no cyclic component, so no edges need to be removed and the graph is acyclic
+        if (0U == currHdr.compCnt)
+        {
+            bestSolSize = 0U;
+            break;
+        }
+
+        retCode = compbest_update(&compBest, &currHdr, currSol, &improved);
+
+        if (ERROR_PARAM == retCode)
+        {
+            // the generator decomposed another graph, its solution does not fit
+            debug("Solution of generator %d does not match the components\n", currHdr.genId);
+            retCode = ERROR_OK;
+            continue;
+        }
+
+        if (ERROR_OK != retCode)
+        {
+            debug("Storing the solution of the component failed\n", NULL);
+            break;
+        }
+
+        // a proven minimum cannot be improved, the generators of the component move on to other ones
+        if ((0U != (currHdr.flags & RECORD_OPTIMAL)) && (currHdr.comp < SHAREDMEM_COMP_CNT))
         {
-            print_solution(currSol, currSolSize);
-            memcpy(bestSol, currSol, sizeof(edge_t) * currSolSize);
-            bestSolSize = currSolSize;
+            __atomic_store_n(&pSharedMem->compSolved[currHdr.comp], true, __ATOMIC_RELAXED);
+        }
+
+        if (improved)
+        {
+            recheck = true;
+
+            // tell the generators of the component, so they can stop evaluating solutions which are not better anyway
+            if (currHdr.comp < SHAREDMEM_COMP_CNT)
+            {
+                __atomic_store_n(&pSharedMem->compBest[currHdr.comp], (size_t)currHdr.edgeCnt, __ATOMIC_RELAXED);
+            }
+
+            // the components share no cycle, so the best solutions of all of them together are the best of the graph
+            if (compbest_complete(&compBest) && (compBest.total < bestSolSize))
+            {
+                retCode = compbest_combine(&compBest, &bestSol, &bestSolCap, &bestSolSize);
+
+                if (ERROR_OK != retCode)
+                {
+                    debug("Growing the best solution failed\n", NULL);
+                    break;
+                }
+
+                print_solution(bestSol, bestSolSize);
+            }
         }
 
-        // no edges needed to be removed, so finish because acyclic
-        if (bestSolSize == 0U)
+        // nothing can be better than the minimum of every component
+        if (compbest_proven(&compBest))
         {
+            proven = true;
             break;
         }
     }
@@ -497,7 +1456,26 @@ int main(int argc, char* argv[])
     }
     
 
-    pSharedMem->flags.genActive = false;
+    __atomic_store_n(&pSharedMem->flags.genActive, false, __ATOMIC_RELEASE);
+    lowerbound_stop(&lowerBound);
+
+    if (0U != opts.threads)
+    {
+        stop_workers(pWorkers, opts.threads, &semaphores, opts.maxSolSize);
+    }
+
+    if (0U != opts.procs)
+    {
+        size_t running = 0U;
+
+        for (size_t i = 0U; (NULL != pool.pPids) && (i < pool.cnt); i++)
+        {
+            running += (0 != pool.pPids[i]) ? 1U : 0U;
+        }
+
+        release_writers(&semaphores, running, opts.maxSolSize);
+        pool_stop(&pool);
+    }
 
     // print the best solution
     switch (bestSolSize)
@@ -509,33 +1487,61 @@ int main(int argc, char* argv[])
             fprintf(stdout, "The graph might not be acyclic, no solution found.\n");
             break;
         default:
-            fprintf(stdout, "The graph might not be acyclic, best solution removes %zu edges.\n", bestSolSize);
+            if (proven)
+            {
+                fprintf(stdout, "The graph is not acyclic, the minimum solution removes %zu edges.\n", bestSolSize);
+            }
+            else
+            {
+                fprintf(stdout, "The graph might not be acyclic, best solution removes %zu edges.\n", bestSolSize);
+            }
             break;
     }
 
+    debug("Duplicates: %zu of %zu solutions\n", pSeen->dups, pSeen->total);
+
     // free the memory
+    free(pSeen);
+    compbest_free(&compBest);
     free(bestSol);
     free(currSol);
     bestSol = NULL;
     currSol = NULL;
 
-    // unmap memory
-    if (munmap(pSharedMem, sizeof(shared_mem_t)) == 0)
+    // the shared graph was created by a generator (or from the file), only the supervisor knows when it is not needed
+    graph_shm_detach(&graphShm);
+
+    if (0U == opts.threads)
+    {
+        shm_unlink(GRAPH_SHM_FILE);
+    }
+
+    if (0U != opts.threads)
     {
-        debug("Unmapping successful\n", NULL);
-        if (0U != shm_unlink(SHAREDMEM_FILE))
+        cleanup_local_semaphores(&semaphores);
+        munmap(pSharedMem, shmSize);
+        free(pWorkers);
+    }
+    else
+    {
+        // unmap memory
+        if (munmap(pSharedMem, shmSize) == 0)
         {
-            debug("Unlinking failed errno: %d\n", errno);
+            debug("Unmapping successful\n", NULL);
+            if (0U != (opts.huge ? unlink(SHAREDMEM_HUGE_DIR "/" SHAREDMEM_FILE) : shm_unlink(SHAREDMEM_FILE)))
+            {
+                debug("Unlinking failed errno: %d\n", errno);
+            } else
+            {
+                debug("Unlinking successful\n", NULL);
+            }
         } else
         {
-            debug("Unlinking successful\n", NULL);
+            debug("Unmapping failed\n", NULL);
         }
-    } else
-    {
-        debug("Unmapping failed\n", NULL);
-    }
 
-    retCode |= cleanup_semaphores(&semaphores);
+        retCode |= cleanup_semaphores(&semaphores);
+    }
 
     // all error should be handled before
     retCode = ERROR_OK;